@@ -0,0 +1,156 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <iostream>
+
+/**
+ * @brief Clase que implementa una estructura Union-Find que puede usarse desde varios hilos a la vez.
+ *
+ * No usa locks: cada elemento guarda en una sola palabra atómica de 64 bits su rango (32 bits altos)
+ * y su padre (32 bits bajos), y todas las modificaciones se hacen con compare-and-swap (CAS).
+ *
+ * - La unión es por rango: se cuelga la raíz con menor (rango, id) bajo la otra. Como el CAS exige
+ *   que la raíz siga siendo raíz con el mismo rango, y los rangos solo crecen, nunca se forman ciclos.
+ * - `find` usa compresión por mitades y `find_division` división de caminos. Un CAS fallido solo
+ *   significa que otro hilo ya cambió ese enlace, así que ninguna operación espera a otra.
+ */
+class ConcurrentUnionFind {
+    std::vector<std::atomic<uint64_t>> nodos; // (rango << 32) | padre de cada elemento
+    int n;                                    // Número total de elementos en la estructura
+
+    static uint64_t empaquetar(uint32_t rango, uint32_t padre){ return ((uint64_t)rango << 32) | padre; }
+    static uint32_t padreDe(uint64_t palabra){ return (uint32_t)palabra; }
+    static uint32_t rangoDe(uint64_t palabra){ return (uint32_t)(palabra >> 32); }
+
+public:
+    /**
+     * @brief Constructor que inicializa la estructura para `N` elementos.
+     *
+     * Inicialmente, cada elemento forma un conjunto independiente de rango 0.
+     *
+     * @param N Número de elementos.
+     */
+    ConcurrentUnionFind(int N) : nodos(N), n(N) {
+        for (int i=0; i<n; i++) nodos[i].store(empaquetar(0, i), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Encuentra la raíz del conjunto de `x`, con compresión por mitades.
+     *
+     * Cada nodo visitado pasa a apuntar a su abuelo, y se continúa desde el abuelo.
+     *
+     * @param x Elemento a buscar.
+     * @return Identificador de la raíz del conjunto al momento de la consulta.
+     */
+    int find(int x){
+        while (true){
+            uint64_t palabra = nodos[x].load(std::memory_order_acquire);
+            uint32_t padre = padreDe(palabra);
+            if (padre == (uint32_t)x) return x;
+
+            uint32_t abuelo = padreDe(nodos[padre].load(std::memory_order_acquire));
+            if (abuelo != padre){
+                nodos[x].compare_exchange_weak(palabra, empaquetar(rangoDe(palabra), abuelo),
+                                               std::memory_order_release, std::memory_order_relaxed);
+            }
+            x = abuelo;
+        }
+    }
+
+    /**
+     * @brief Encuentra la raíz del conjunto de `x`, con división de caminos.
+     *
+     * Cada nodo visitado pasa a apuntar a su abuelo, y se continúa desde el padre original.
+     *
+     * @param x Elemento a buscar.
+     * @return Identificador de la raíz del conjunto al momento de la consulta.
+     */
+    int find_division(int x){
+        while (true){
+            uint64_t palabra = nodos[x].load(std::memory_order_acquire);
+            uint32_t padre = padreDe(palabra);
+            if (padre == (uint32_t)x) return x;
+
+            uint32_t abuelo = padreDe(nodos[padre].load(std::memory_order_acquire));
+            if (abuelo != padre){
+                nodos[x].compare_exchange_weak(palabra, empaquetar(rangoDe(palabra), abuelo),
+                                               std::memory_order_release, std::memory_order_relaxed);
+            }
+            x = padre;
+        }
+    }
+
+    /**
+     * @brief Une los conjuntos de `x` e `y`.
+     *
+     * A diferencia de `UnionFind::union_`, no es necesario entregar raíces: si otro hilo modifica
+     * los conjuntos al mismo tiempo, se vuelven a buscar las raíces y se reintenta.
+     *
+     * @param x Elemento del primer conjunto.
+     * @param y Elemento del segundo conjunto.
+     * @return true si los conjuntos se unieron, false si ya eran el mismo.
+     */
+    bool union_(int x, int y){
+        while (true){
+            x = find(x);
+            y = find(y);
+            if (x == y) return false;
+
+            uint64_t palabraX = nodos[x].load(std::memory_order_acquire);
+            uint64_t palabraY = nodos[y].load(std::memory_order_acquire);
+            if (padreDe(palabraX) != (uint32_t)x || padreDe(palabraY) != (uint32_t)y) continue; // ya no son raíces
+
+            // Se cuelga la raíz con menor (rango, id) bajo la otra
+            uint32_t rangoX = rangoDe(palabraX), rangoY = rangoDe(palabraY);
+            if (rangoX > rangoY || (rangoX == rangoY && x > y)){
+                std::swap(x, y);
+                std::swap(palabraX, palabraY);
+                std::swap(rangoX, rangoY);
+            }
+            if (!nodos[x].compare_exchange_strong(palabraX, empaquetar(rangoX, y),
+                                                  std::memory_order_acq_rel, std::memory_order_relaxed)) continue;
+
+            // Si los rangos eran iguales se intenta subir el de la nueva raíz; si falla es porque
+            // dejó de ser raíz o alguien más ya lo subió, y el orden entre raíces se mantiene igual.
+            if (rangoX == rangoY){
+                nodos[y].compare_exchange_strong(palabraY, empaquetar(rangoY + 1, y),
+                                                 std::memory_order_acq_rel, std::memory_order_relaxed);
+            }
+            return true;
+        }
+    }
+
+    /**
+     * @brief Indica si `x` e `y` están en el mismo conjunto.
+     *
+     * Es seguro llamarla mientras otros hilos hacen uniones; la respuesta es correcta para algún
+     * instante durante la llamada.
+     */
+    bool mismoConjunto(int x, int y){
+        while (true){
+            x = find(x);
+            y = find(y);
+            if (x == y) return true;
+            // Si x sigue siendo raíz, en este instante x e y estaban en conjuntos distintos
+            if (padreDe(nodos[x].load(std::memory_order_acquire)) == (uint32_t)x) return false;
+        }
+    }
+
+    /**
+     * @brief Imprime el arreglo de padres, que representa la estructura del bosque de conjuntos.
+     *
+     * @param i (opcional) Índice para nombrar el conjunto en la salida.
+     */
+    void printPadres(int i=-1) {
+        if (i != -1)
+            std::cout << "padres" << i << " = [";
+        else
+            std::cout << "padres = [";
+        for (int k = 0; k < n; ++k) {
+            std::cout << padreDe(nodos[k].load());
+            if (k < n - 1) std::cout << ", ";
+        }
+        std::cout << "]" << std::endl;
+    }
+};
@@ -1,17 +1,65 @@
+#pragma once
 #include <vector>
 #include <iostream>
 #include <string>
+#include "instrumentacion.cpp"
+#include "arena.cpp"
+
+/**
+ * @brief Estrategias de compresión de caminos que puede aplicar `find`.
+ */
+enum Compresion {
+    COMPRESION_COMPLETA,  // todos los nodos del camino quedan apuntando a la raíz
+    COMPRESION_MITADES,   // cada nodo visitado apunta a su abuelo y se salta al abuelo (path halving)
+    DIVISION_CAMINOS,     // cada nodo visitado apunta a su abuelo y se sigue por el padre (path splitting)
+    SIN_COMPRESION        // no se modifica el bosque
+};
+
+/**
+ * @brief Criterios para decidir qué raíz queda arriba al unir dos conjuntos.
+ */
+enum CriterioUnion {
+    UNION_TAMANO,  // el conjunto con menos elementos se cuelga del más grande
+    UNION_RANGO    // el árbol de menor rango (cota de su altura) se cuelga del de mayor rango
+};
 
 /**
  * @brief Clase que implementa una estructura Union-Find
  *
  * Esta estructura permite gestionar particiones disjuntas de elementos, soportando
  * operaciones eficientes de unión y búsqueda.
+ *
+ * Las estrategias se eligen en tiempo de compilación, así que no hay costo de llamadas virtuales
+ * al compararlas. Todas las búsquedas son iterativas y la memoria se libera al destruir la estructura.
+ * Los arreglos salen de la arena activa al construirla, si hay una (ver `AlcanceArena`).
+ *
+ * @tparam C Compresión de caminos que aplica `find`.
+ * @tparam U Criterio de unión.
+ * @tparam ArregloUnico Si es true se usa un solo arreglo: las raíces guardan su tamaño (o rango + 1)
+ *         con signo negativo en vez de apuntarse a sí mismas, lo que ahorra la mitad de la memoria.
  */
-class UnionFind {
-    int *padre;     // Arreglo que marca quien es el padre de cada nodo
-    int *treeSize;  // Arreglo con el número de hijos de cada nodo
-    int n;          // Número total de elementos en la estructura
+template <Compresion C = COMPRESION_COMPLETA, CriterioUnion U = UNION_TAMANO, bool ArregloUnico = false>
+class UnionFindPolitica {
+    VectorArena<int> padre;     // Arreglo que marca quien es el padre de cada nodo
+    VectorArena<int> treeSize;  // Tamaño o rango de cada raíz (vacío si ArregloUnico)
+    int n;                      // Número total de elementos en la estructura
+
+    bool esRaiz(int x) const {
+        if constexpr (ArregloUnico) return padre[x] < 0;
+        else return padre[x] == x;
+    }
+
+    // Tamaño o rango de una raíz
+    int valor(int raiz) const {
+        if constexpr (ArregloUnico) return -padre[raiz];
+        else return treeSize[raiz];
+    }
+
+    void asignarValor(int raiz, int v){
+        if constexpr (ArregloUnico) padre[raiz] = -v;
+        else treeSize[raiz] = v;
+    }
+
 public:
 
      /**
@@ -21,45 +69,82 @@ public:
      *
      * @param N Número de elementos.
      */
-    UnionFind(int N){
-        n = N;
-        padre = new int[n];
-        treeSize = new int[n];
-        for(int i=0; i<n; i++){
-            padre[i] = i; // Cada nodo parte siendo su propio padre
-            treeSize[i] = 1;
+    UnionFindPolitica(int N) : n(N) {
+        if constexpr (ArregloUnico){
+            padre.assign(n, -1); // tamaño 1, o rango 0 guardado como 0 + 1
+        } else {
+            padre.resize(n);
+            for(int i=0; i<n; i++) padre[i] = i; // Cada nodo parte siendo su propio padre
+            treeSize.assign(n, U == UNION_TAMANO ? 1 : 0);
         }
     }
 
     /**
      * @brief Une dos árboles por sus raíces.
      *
-     * Une por tamaño, el conjunto más pequeño se conecta al más grande.
+     * Según el criterio `U`, une por tamaño (el conjunto más pequeño se conecta al más grande)
+     * o por rango (el árbol más bajo se conecta al más alto).
      *
      * @param raiz_x Raíz del primer conjunto.
      * @param raiz_y Raíz del segundo conjunto.
      */
     void union_(int raiz_x, int raiz_y){
-        if ( treeSize[raiz_x]< treeSize[raiz_y]) std::swap(raiz_x, raiz_y); // se hace la union al de menor treeSize
+        CONTAR(uniones, 1);
+        int vx = valor(raiz_x), vy = valor(raiz_y);
+        if (vx < vy){ // se hace la union al de menor treeSize (o rango)
+            std::swap(raiz_x, raiz_y);
+            std::swap(vx, vy);
+        }
 
         padre[raiz_y] = raiz_x;
-        
-        treeSize[raiz_x]+= treeSize[raiz_y];
-        
+
+        if constexpr (U == UNION_TAMANO) asignarValor(raiz_x, vx + vy);
+        else if (vx == vy) asignarValor(raiz_x, vx + 1);
     }
 
      /**
-     * @brief Encuentra la raíz del conjunto al que pertenece un elemento, con compresión de caminos.
-     *
-     * Optimiza futuras búsquedas al hacer que todos los nodos visitados apunten directamente a la raíz.
+     * @brief Encuentra la raíz del conjunto al que pertenece un elemento, con la compresión `C`.
      *
      * @param x Elemento a buscar.
      * @return Identificador de la raíz del conjunto.
      */
     int find(int x){
-        if(padre[x] != x) padre[x] = find(padre[x]); // Modifica el padre del nodo actual por la raiz
-
-        return padre[x];
+        CONTAR(llamadasFind, 1);
+        if constexpr (C == COMPRESION_COMPLETA){
+            int raiz = x;
+            while (!esRaiz(raiz)){
+                raiz = padre[raiz];
+                CONTAR(largoCaminos, 1);
+            }
+            while (x != raiz){ // Modifica el padre de cada nodo del camino por la raiz
+                int siguiente = padre[x];
+                padre[x] = raiz;
+                x = siguiente;
+            }
+            return raiz;
+        } else if constexpr (C == COMPRESION_MITADES){
+            while (!esRaiz(x)){
+                int p = padre[x];
+                if (!esRaiz(p)) padre[x] = padre[p];
+                x = padre[x];
+                CONTAR(largoCaminos, 1);
+            }
+            return x;
+        } else if constexpr (C == DIVISION_CAMINOS){
+            while (!esRaiz(x)){
+                int p = padre[x];
+                if (!esRaiz(p)) padre[x] = padre[p];
+                x = p;
+                CONTAR(largoCaminos, 1);
+            }
+            return x;
+        } else {
+            while (!esRaiz(x)){
+                x = padre[x];
+                CONTAR(largoCaminos, 1);
+            }
+            return x;
+        }
     }
 
     /**
@@ -68,14 +153,16 @@ public:
      * @param x Elemento a buscar.
      * @return Identificador de la raíz del conjunto.
      */
-    int find_no_opt(int x) {
-        if (padre[x] == x) return x; // caso base
-        return find_no_opt(padre[x]);
+    int find_no_opt(int x) const {
+        while (!esRaiz(x)) x = padre[x];
+        return x;
     }
 
     /**
      * @brief Imprime el arreglo de padres, que representa la estructura del bosque de conjuntos.
      *
+     * Las raíces se muestran apuntándose a sí mismas en cualquier representación.
+     *
      * @param i (opcional) Índice para nombrar el conjunto en la salida.
      */
     void printPadres(int i=-1) {
@@ -83,15 +170,17 @@ public:
             std::cout << "padres" << i << " = [";
         else
             std::cout << "padres = [";
-        for (size_t i = 0; i < n; ++i) {
-            std::cout << padre[i];
-            if (i < n - 1) std::cout << ", ";
+        for (int k = 0; k < n; ++k) {
+            std::cout << (esRaiz(k) ? k : padre[k]);
+            if (k < n - 1) std::cout << ", ";
         }
         std::cout << "]" << std::endl;
     }
 
     /**
-     * @brief Imprime los tamaños de árbol de cada conjunto.
+     * @brief Imprime los tamaños (o rangos) de árbol de cada conjunto.
+     *
+     * Con un arreglo único solo las raíces guardan este valor; los demás nodos se muestran con 0.
      *
      * @param i (opcional) Índice para nombrar el conjunto en la salida.
      */
@@ -100,10 +189,18 @@ public:
             std::cout << "treeSize" << i << " = [";
         else
             std::cout << "treeSize = [";
-        for (size_t i = 0; i < n; ++i) {
-            std::cout << treeSize[i];
-            if (i < n - 1) std::cout << ", ";
+        for (int k = 0; k < n; ++k) {
+            int v = esRaiz(k) ? valor(k) : 0;
+            if constexpr (!ArregloUnico) v = treeSize[k];
+            else if (U == UNION_RANGO && esRaiz(k)) v -= 1;
+            std::cout << v;
+            if (k < n - 1) std::cout << ", ";
         }
         std::cout << "]" << std::endl;
     }
-};
\ No newline at end of file
+};
+
+/**
+ * @brief Union-Find por tamaño con compresión completa de caminos, la versión usada por defecto.
+ */
+typedef UnionFindPolitica<> UnionFind;
@@ -0,0 +1,295 @@
+#pragma once
+#include <algorithm>    // std::sort, std::min, std::max
+#include <cmath>
+#include <cstdint>
+#include <cstring>      // std::memcpy
+#include "geometrico.cpp"
+#include "kruskal.cpp"
+#include "arena.cpp"
+
+// MST euclidiano aproximado: cambia un error acotado en el peso total por no tener que ordenar
+// las aristas exactamente ni buscar vecinos con el árbol k-d para la mayoría de los puntos.
+//
+// 1. Los puntos se reparten en una grilla de celdas de lado h. Todo par a distancia a lo más h
+//    queda en la misma celda o en celdas vecinas, así que se pueden generar todas las aristas
+//    de peso ≤ h² mirando solo 9 celdas por punto.
+// 2. Esas aristas se ordenan por cubetas de peso relativo 1 + ε con un conteo de una pasada, y se
+//    procesan con Kruskal sin ordenar dentro de cada cubeta.
+// 3. Las componentes que quedan se unen con `unirComponentesGeometrico`, que es exacto.
+//
+// El árbol obtenido es un MST exacto para pesos w'' con w ≤ w'' ≤ (1 + ε) w (el peso redondeado
+// al borde superior de su cubeta y truncado a h²; las aristas del paso 3 pesan más que h²), así
+// que su peso total es a lo más (1 + ε) veces el del MST. Como los pesos son distancias al cuadrado,
+// la suma de las distancias euclidianas queda a lo más sqrt(1 + ε) veces la óptima.
+
+/**
+ * @brief Arista entre dos puntos de la grilla, por sus ids.
+ */
+struct AristaGrilla {
+    double peso;
+    uint32_t u, v;
+};
+
+/**
+ * @brief Número de bits de mantisa que se conservan para que las cubetas tengan ancho relativo a lo más `epsilon`.
+ *
+ * Con k bits el ancho relativo es 2^-k; si `epsilon` es 0 o negativo se conservan los 52 bits (orden exacto).
+ */
+int bitsMantisaPara(double epsilon){
+    int k = 0;
+    while (k < 52 && !(std::ldexp(1.0, -k) <= epsilon)) k++;
+    return k;
+}
+
+/**
+ * @brief Cubeta de un peso no negativo: sus bits IEEE-754 sin los 52 - k bits menos significativos de la mantisa.
+ *
+ * El orden de las cubetas es el de los pesos, y dentro de una cubeta los pesos difieren en un factor menor que 1 + 2^-k.
+ */
+inline uint64_t cubetaPeso(double peso, int bitsMantisa){
+    uint64_t bits;
+    std::memcpy(&bits, &peso, sizeof(bits));
+    return bits >> (52 - bitsMantisa);
+}
+
+/**
+ * @brief Peso máximo de las aristas que genera `aristasGrilla` con celdas de lado `lado`.
+ *
+ * Es un poco menos que lado², para que el redondeo al calcular las celdas no deje fuera ningún par.
+ */
+inline double pesoMaximoGrilla(double lado){
+    return lado * lado * (1 - 1e-9);
+}
+
+/**
+ * @brief Genera todas las aristas de peso a lo más `pesoMaximoGrilla(lado)` con una grilla de celdas de lado `lado`.
+ *
+ * Antes de generarlas cuenta los pares de puntos en celdas vecinas; si son más de `maxPares`
+ * no genera nada y retorna false, para que se pruebe con celdas más pequeñas.
+ *
+ * @param V Nodos del grafo; `V[i].id` debe ser `i`.
+ * @param lado Lado de las celdas.
+ * @param maxPares Máximo de pares de puntos que se aceptan revisar.
+ * @param aristas Vector al que se agregan las aristas.
+ * @return false si habría que revisar más de `maxPares` pares.
+ */
+bool aristasGrilla(const std::vector<Node>& V, double lado, size_t maxPares, VectorArena<AristaGrilla>& aristas){
+    size_t n = V.size();
+    double minX = V[0].x, minY = V[0].y, maxX = V[0].x;
+    for (const Node& p : V){
+        minX = std::min(minX, p.x);
+        minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x);
+    }
+    // Las columnas van de 1 a `columnas`, así las vecinas de la primera y la última también tienen clave
+    uint64_t columnas = (uint64_t)((maxX - minX) / lado) + 1;
+    uint64_t ancho = columnas + 2;
+    auto clave = [&](const Node& p){
+        uint64_t cx = (uint64_t)((p.x - minX) / lado) + 1;
+        uint64_t cy = (uint64_t)((p.y - minY) / lado) + 1;
+        return cy * ancho + cx;
+    };
+
+    // Puntos ordenados por celda, y el rango de cada celda
+    VectorArena<std::pair<uint64_t, uint32_t>> orden(n);
+    for (size_t i=0; i<n; i++) orden[i] = {clave(V[i]), (uint32_t)i};
+    std::sort(orden.begin(), orden.end());
+    VectorArena<uint64_t> claves;
+    VectorArena<size_t> inicio;
+    for (size_t i=0; i<n; i++){
+        if (i == 0 || orden[i].first != orden[i-1].first){
+            claves.push_back(orden[i].first);
+            inicio.push_back(i);
+        }
+    }
+    inicio.push_back(n);
+    size_t celdas = claves.size();
+
+    // Rango de puntos de las celdas con clave en [desde, hasta]
+    auto rango = [&](uint64_t desde, uint64_t hasta, size_t& a, size_t& b){
+        a = inicio[std::lower_bound(claves.begin(), claves.end(), desde) - claves.begin()];
+        b = inicio[std::upper_bound(claves.begin(), claves.end(), hasta) - claves.begin()];
+    };
+
+    // Cada par se revisa una vez: la misma celda, la de la derecha y las tres de la fila siguiente
+    size_t pares = 0;
+    for (size_t c=0; c<celdas && pares<=maxPares; c++){
+        size_t cantidad = inicio[c+1] - inicio[c];
+        size_t a, b, d, e;
+        rango(claves[c] + 1, claves[c] + 1, a, b);
+        rango(claves[c] + ancho - 1, claves[c] + ancho + 1, d, e);
+        pares += cantidad * (cantidad - 1) / 2 + cantidad * (b - a + e - d);
+    }
+    if (pares > maxPares) return false;
+
+    double maximo = pesoMaximoGrilla(lado);
+    auto agregar = [&](uint32_t i, size_t desde, size_t hasta){
+        for (size_t k=desde; k<hasta; k++){
+            uint32_t j = orden[k].second;
+            double peso = distanciaCuadrada(&V[i], &V[j]);
+            if (peso <= maximo) aristas.push_back({peso, std::min(i, j), std::max(i, j)});
+        }
+    };
+    aristas.reserve(aristas.size() + pares);
+    for (size_t c=0; c<celdas; c++){
+        size_t a, b, d, e;
+        rango(claves[c] + 1, claves[c] + 1, a, b);
+        rango(claves[c] + ancho - 1, claves[c] + ancho + 1, d, e);
+        for (size_t k=inicio[c]; k<inicio[c+1]; k++){
+            uint32_t i = orden[k].second;
+            agregar(i, k + 1, inicio[c+1]);
+            agregar(i, a, b);
+            agregar(i, d, e);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Ordena aristas de peso a lo más `maximo` por cubetas de ancho relativo 2^-k, con un conteo.
+ *
+ * Se usan las cubetas desde la de la arista más liviana, hasta 2^16 de ellas; las aristas más
+ * livianas que la última cubeta van a la primera, que sí se ordena exactamente. Así el resultado
+ * respeta el ancho de las cubetas aunque haya pesos muy pequeños o nulos.
+ *
+ * @param aristas Aristas por ordenar.
+ * @param maximo Cota superior de los pesos.
+ * @param bitsMantisa Bits de mantisa de las cubetas (ver `cubetaPeso`).
+ */
+void ordenarPorCubetas(VectorArena<AristaGrilla>& aristas, double maximo, int bitsMantisa){
+    const uint64_t CUBETAS = 1 << 16;
+    size_t m = aristas.size();
+    uint64_t alta = cubetaPeso(maximo, bitsMantisa);
+    uint64_t baja = alta >= CUBETAS - 1 ? alta - (CUBETAS - 1) : 0;
+    uint64_t menor = alta;
+    for (const AristaGrilla& e : aristas) menor = std::min(menor, cubetaPeso(e.peso, bitsMantisa));
+    baja = std::max(baja, menor); // no se cuentan cubetas más livianas que todas las aristas
+    auto cubeta = [&](const AristaGrilla& e){
+        uint64_t c = cubetaPeso(e.peso, bitsMantisa);
+        return c <= baja ? 0 : c - baja;
+    };
+
+    VectorArena<size_t> conteo(alta - baja + 2);
+    for (const AristaGrilla& e : aristas) conteo[cubeta(e) + 1]++;
+    for (size_t c=1; c<conteo.size(); c++) conteo[c] += conteo[c-1];
+    size_t primera = conteo[1]; // aristas de la cubeta 0
+
+    VectorArena<AristaGrilla> buffer(m);
+    for (const AristaGrilla& e : aristas) buffer[conteo[cubeta(e)]++] = e;
+    std::sort(buffer.begin(), buffer.begin() + primera,
+        [](const AristaGrilla& a, const AristaGrilla& b){ return a.peso < b.peso; });
+    aristas.swap(buffer);
+}
+
+/**
+ * @brief MST euclidiano aproximado, con peso total a lo más (1 + ε) veces el óptimo.
+ *
+ * Ver el comentario al inicio de `aproximado.cpp`. El lado de la grilla se elige para que haya unos
+ * 4 puntos por celda en promedio; si la distribución es muy irregular y habría demasiados pares que
+ * revisar, se achica a la mitad hasta que no los haya. Si ni así se logra, todas las aristas salen
+ * del paso exacto y el resultado es el mismo de `kruskal_geometrico`.
+ *
+ * Con ε = 0 el árbol es un MST exacto.
+ *
+ * ### Ejemplo de uso:
+ * @code
+ * std::vector<Node> nodos = generarPuntos(1 << 20, 42);
+ * for (size_t i=0; i<nodos.size(); i++) nodos[i].id = i;
+ * std::vector<Edge> mst = mst_aproximado(nodos, 0.05);
+ * @endcode
+ *
+ * @param V Nodos del grafo; `V[i].id` debe ser `i`.
+ * @param epsilon Error relativo máximo del peso total.
+ * @return Las N-1 aristas del árbol, ordenadas por cubeta de peso y no exactamente por peso.
+ */
+std::vector<Edge> mst_aproximado(std::vector<Node>& V, double epsilon){
+    const double PUNTOS_POR_CELDA = 4;
+    const size_t PARES_POR_PUNTO = 32; // máximo de pares revisados en la grilla, por punto
+    const int MAX_DIVISIONES = 30;
+
+    int n = V.size();
+    std::vector<Edge> result;
+    if (n < 2) return result;
+    result.reserve(n - 1);
+
+    double minX = V[0].x, minY = V[0].y, maxX = V[0].x, maxY = V[0].y;
+    for (const Node& p : V){
+        minX = std::min(minX, p.x); maxX = std::max(maxX, p.x);
+        minY = std::min(minY, p.y); maxY = std::max(maxY, p.y);
+    }
+    double extension = std::max(maxX - minX, maxY - minY);
+    double area = std::max((maxX - minX) * (maxY - minY), extension * extension / n); // puntos casi en una recta
+    double lado = std::sqrt(area * PUNTOS_POR_CELDA / n);
+
+    VectorArena<AristaGrilla> aristas;
+    bool conGrilla = false;
+    for (int d=0; lado > 0 && d <= MAX_DIVISIONES; d++){
+        conGrilla = aristasGrilla(V, lado, PARES_POR_PUNTO * n, aristas);
+        if (conGrilla) break;
+        lado /= 2;
+    }
+
+    UnionFind uf(n);
+    if (conGrilla){
+        ordenarPorCubetas(aristas, pesoMaximoGrilla(lado), bitsMantisaPara(epsilon));
+        for (const AristaGrilla& e : aristas){
+            int raiz_x = uf.find(e.u);
+            int raiz_y = uf.find(e.v);
+
+            if (raiz_x != raiz_y) {
+                uf.union_(raiz_x, raiz_y);
+                result.push_back(Edge(&V[e.u], &V[e.v]));
+                if (result.size() == n - 1) break; // cuando se encuentran n-1 aristas se termina
+            }
+        }
+    }
+    unirComponentesGeometrico(V, uf, n - result.size(), result);
+    return result;
+}
+
+/**
+ * @brief MST aproximado de un grafo completo; solo usa sus nodos (`G.V`).
+ */
+std::vector<Edge> mst_aproximado(Graph& G, double epsilon){
+    return mst_aproximado(G.V, epsilon);
+}
+
+/**
+ * @brief MST aproximado de un grafo implícito.
+ */
+std::vector<Edge> mst_aproximado(ImplicitGraph& G, double epsilon){
+    return mst_aproximado(G.V, epsilon);
+}
+
+/**
+ * @brief Resultado de comparar el MST aproximado con el exacto.
+ */
+struct VerificacionAproximada {
+    double pesoExacto = 0;       // peso del MST exacto
+    double pesoAproximado = 0;   // peso del árbol de `mst_aproximado`
+    double errorRelativo = 0;    // (pesoAproximado - pesoExacto) / pesoExacto
+    double cota = 0;             // error relativo máximo garantizado, 2^-k <= ε
+};
+
+/**
+ * @brief Compara el árbol de `mst_aproximado` con un MST exacto de los mismos nodos.
+ *
+ * @param V Nodos del grafo; `V[i].id` debe ser `i`.
+ * @param mstExacto MST exacto de los nodos.
+ * @param epsilon Error relativo máximo pedido a `mst_aproximado`.
+ */
+VerificacionAproximada verificarAproximado(std::vector<Node>& V, const std::vector<Edge>& mstExacto, double epsilon){
+    VerificacionAproximada r;
+    for (const Edge& e : mstExacto) r.pesoExacto += e.peso;
+    for (const Edge& e : mst_aproximado(V, epsilon)) r.pesoAproximado += e.peso;
+    if (r.pesoExacto > 0) r.errorRelativo = (r.pesoAproximado - r.pesoExacto) / r.pesoExacto;
+    r.cota = std::ldexp(1.0, -bitsMantisaPara(epsilon));
+    return r;
+}
+
+/**
+ * @brief Compara el árbol de `mst_aproximado` con el de `kruskal_array_Opti` sobre el mismo grafo.
+ */
+VerificacionAproximada verificarAproximado(Graph& G, double epsilon){
+    return verificarAproximado(G.V, kruskal_array_Opti(G), epsilon);
+}
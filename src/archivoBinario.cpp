@@ -0,0 +1,310 @@
+#pragma once
+#include <algorithm>    // std::sort
+#include <climits>      // INT_MAX
+#include <cstdint>
+#include <cstring>      // std::memcmp, std::memcpy
+#include <fstream>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "UnionFind.cpp"
+#include "geometrico.cpp"
+
+// Formato binario de puntos, aristas y MST.
+//
+// El archivo tiene una cabecera de 64 bytes seguida de tres arreglos contiguos, cada uno alineado a 8 bytes:
+// los puntos, las aristas (opcional) y las aristas del MST (opcional). Los enteros y reales se guardan
+// en el orden de bytes de la máquina (little-endian en x86 y ARM), por lo que el archivo se puede mapear
+// a memoria y usar directamente, sin convertir ni copiar.
+
+/**
+ * @brief Cabecera del archivo binario.
+ *
+ * Los inicios son posiciones en bytes desde el comienzo del archivo.
+ */
+struct CabeceraArchivo {
+    char magia[8];            // "MSTBIN\0\0"
+    uint32_t version;
+    uint32_t reservado;
+    uint64_t numPuntos;
+    uint64_t numAristas;      // 0 si el archivo no trae aristas
+    uint64_t numMST;          // 0 si el archivo no trae MST
+    uint64_t inicioPuntos;
+    uint64_t inicioAristas;
+    uint64_t inicioMST;
+};
+
+/**
+ * @brief Punto tal como se guarda en el archivo; su id es su posición.
+ */
+struct PuntoBinario {
+    double x;
+    double y;
+};
+
+/**
+ * @brief Arista tal como se guarda en el archivo: ids de sus nodos y su peso.
+ */
+struct AristaBinaria {
+    uint32_t u;
+    uint32_t v;
+    double peso;
+};
+
+const char MAGIA_ARCHIVO[8] = {'M', 'S', 'T', 'B', 'I', 'N', 0, 0};
+const uint32_t VERSION_ARCHIVO = 1;
+
+static_assert(sizeof(CabeceraArchivo) == 64, "la cabecera debe ocupar 64 bytes");
+static_assert(sizeof(PuntoBinario) == 16 && sizeof(AristaBinaria) == 16, "los registros deben ocupar 16 bytes");
+
+/**
+ * @class ArchivoMST
+ * @brief Archivo binario de puntos, aristas y MST mapeado a memoria.
+ *
+ * Los arreglos se leen directamente del mapeo, que es de solo lectura: abrir un archivo de varios GB
+ * no copia nada y el sistema operativo carga las páginas a medida que se usan. Como nunca se escriben,
+ * las páginas siguen respaldadas por el archivo y el sistema puede descartarlas si falta memoria.
+ *
+ * ### Ejemplo de uso:
+ * @code
+ * ArchivoMST archivo;
+ * if (archivo.abrir("puntos.bin")){
+ *     std::vector<Node> nodos = archivo.nodos();
+ * }
+ * @endcode
+ */
+class ArchivoMST {
+    void* mapeo = MAP_FAILED;
+    size_t largo = 0;
+
+    const CabeceraArchivo& cabecera() const { return *(const CabeceraArchivo*)mapeo; }
+
+    // Verifica que un arreglo de `cantidad` registros en `inicio` esté alineado y dentro del archivo
+    bool arregloValido(uint64_t inicio, uint64_t cantidad) const {
+        if (cantidad == 0) return true;
+        return inicio % 8 == 0 && inicio >= sizeof(CabeceraArchivo) && inicio <= largo
+            && cantidad <= (largo - inicio) / 16;
+    }
+
+public:
+    ArchivoMST() {}
+    ArchivoMST(const ArchivoMST&) = delete;
+    ArchivoMST& operator=(const ArchivoMST&) = delete;
+    ~ArchivoMST(){ cerrar(); }
+
+    /**
+     * @brief Mapea un archivo a memoria y valida su cabecera.
+     *
+     * Se rechazan los archivos con más de INT_MAX puntos, que no caben en los ids de `Node` ni en `UnionFind`.
+     *
+     * @param ruta Ruta del archivo.
+     * @return true si el archivo se pudo abrir y tiene un formato válido, false en caso contrario.
+     */
+    bool abrir(const std::string& ruta){
+        cerrar();
+        int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd == -1){
+            std::cerr << "No se pudo abrir '" << ruta << "'\n";
+            return false;
+        }
+        struct stat info;
+        if (fstat(fd, &info) == -1 || (size_t)info.st_size < sizeof(CabeceraArchivo)){
+            std::cerr << "'" << ruta << "' es demasiado corto para ser un archivo MST\n";
+            close(fd);
+            return false;
+        }
+        largo = info.st_size;
+        mapeo = mmap(nullptr, largo, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd); // el mapeo se mantiene aunque se cierre el descriptor
+        if (mapeo == MAP_FAILED){
+            std::cerr << "No se pudo mapear '" << ruta << "' a memoria\n";
+            largo = 0;
+            return false;
+        }
+
+        const CabeceraArchivo& c = cabecera();
+        if (std::memcmp(c.magia, MAGIA_ARCHIVO, sizeof(c.magia)) != 0 || c.version != VERSION_ARCHIVO
+            || !arregloValido(c.inicioPuntos, c.numPuntos) || !arregloValido(c.inicioAristas, c.numAristas)
+            || !arregloValido(c.inicioMST, c.numMST)){
+            std::cerr << "'" << ruta << "' no es un archivo MST válido\n";
+            cerrar();
+            return false;
+        }
+        if (c.numPuntos > INT_MAX){
+            std::cerr << "'" << ruta << "' tiene " << c.numPuntos << " puntos; se admiten a lo más " << INT_MAX << "\n";
+            cerrar();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Libera el mapeo; no hace nada si no hay un archivo abierto.
+     */
+    void cerrar(){
+        if (mapeo != MAP_FAILED) munmap(mapeo, largo);
+        mapeo = MAP_FAILED;
+        largo = 0;
+    }
+
+    size_t numPuntos() const { return cabecera().numPuntos; }
+    size_t numAristas() const { return cabecera().numAristas; }
+    size_t numMST() const { return cabecera().numMST; }
+    uint64_t inicioAristas() const { return cabecera().inicioAristas; }
+
+    const PuntoBinario* puntos() const { return (const PuntoBinario*)((const char*)mapeo + cabecera().inicioPuntos); }
+    const AristaBinaria* mst() const { return (const AristaBinaria*)((const char*)mapeo + cabecera().inicioMST); }
+
+    const AristaBinaria* aristas() const { return (const AristaBinaria*)((const char*)mapeo + cabecera().inicioAristas); }
+
+    /**
+     * @brief Copia los puntos a nodos con id igual a su posición, para usarlos con `Graph` o `ImplicitGraph`.
+     */
+    std::vector<Node> nodos() const {
+        std::vector<Node> V;
+        V.reserve(numPuntos());
+        const PuntoBinario* p = puntos();
+        for (size_t k=0; k<numPuntos(); k++){
+            V.push_back(Node(p[k].x, p[k].y));
+            V.back().id = k;
+        }
+        return V;
+    }
+};
+
+/**
+ * @brief Escribe un archivo binario a partir de sus tres arreglos.
+ *
+ * @param ruta Ruta del archivo; se sobrescribe si existe.
+ * @param puntos Puntos, con id igual a su posición.
+ * @param numPuntos Número de puntos.
+ * @param aristas Aristas (puede ser nulo si `numAristas` es 0).
+ * @param numAristas Número de aristas.
+ * @param mst Aristas del MST (puede ser nulo si `numMST` es 0).
+ * @param numMST Número de aristas del MST.
+ * @return true si el archivo se escribió completo, false en caso contrario.
+ */
+bool escribirArchivoMST(const std::string& ruta, const PuntoBinario* puntos, uint64_t numPuntos,
+                        const AristaBinaria* aristas, uint64_t numAristas,
+                        const AristaBinaria* mst, uint64_t numMST){
+    CabeceraArchivo c;
+    std::memcpy(c.magia, MAGIA_ARCHIVO, sizeof(c.magia));
+    c.version = VERSION_ARCHIVO;
+    c.reservado = 0;
+    c.numPuntos = numPuntos;
+    c.numAristas = numAristas;
+    c.numMST = numMST;
+    c.inicioPuntos = sizeof(CabeceraArchivo);
+    c.inicioAristas = c.inicioPuntos + numPuntos * sizeof(PuntoBinario);
+    c.inicioMST = c.inicioAristas + numAristas * sizeof(AristaBinaria);
+
+    std::ofstream archivo(ruta, std::ios::binary | std::ios::trunc);
+    archivo.write((const char*)&c, sizeof(c));
+    archivo.write((const char*)puntos, numPuntos * sizeof(PuntoBinario));
+    archivo.write((const char*)aristas, numAristas * sizeof(AristaBinaria));
+    archivo.write((const char*)mst, numMST * sizeof(AristaBinaria));
+    archivo.close();
+    if (!archivo){
+        std::cerr << "No se pudo escribir '" << ruta << "'\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Convierte aristas de un grafo al formato del archivo.
+ */
+std::vector<AristaBinaria> aristasBinarias(const std::vector<Edge>& edges){
+    std::vector<AristaBinaria> resultado(edges.size());
+    for (size_t k=0; k<edges.size(); k++) resultado[k] = {(uint32_t)edges[k].n1->id, (uint32_t)edges[k].n2->id, edges[k].peso};
+    return resultado;
+}
+
+/**
+ * @brief Escribe los nodos de un grafo, su MST y opcionalmente sus aristas.
+ *
+ * ### Ejemplo de uso:
+ * @code
+ * Graph G(nodos);
+ * escribirArchivoMST("mst.bin", G.V, kruskal_array_Opti(G));
+ * @endcode
+ *
+ * @param ruta Ruta del archivo; se sobrescribe si existe.
+ * @param V Nodos del grafo; `V[i].id` debe ser `i`.
+ * @param mst Aristas del MST; puede ser vacío para guardar solo los puntos.
+ * @param aristas Aristas del grafo, si se quieren guardar.
+ * @return true si el archivo se escribió completo, false en caso contrario.
+ */
+bool escribirArchivoMST(const std::string& ruta, const std::vector<Node>& V,
+                        const std::vector<Edge>& mst, const std::vector<Edge>& aristas = {}){
+    std::vector<PuntoBinario> puntos(V.size());
+    for (size_t k=0; k<V.size(); k++) puntos[k] = {V[k].x, V[k].y};
+    std::vector<AristaBinaria> binAristas = aristasBinarias(aristas);
+    std::vector<AristaBinaria> binMST = aristasBinarias(mst);
+    return escribirArchivoMST(ruta, puntos.data(), puntos.size(), binAristas.data(), binAristas.size(),
+                              binMST.data(), binMST.size());
+}
+
+/**
+ * @brief Kruskal sobre las aristas mapeadas de un archivo, ordenando solo sus índices.
+ *
+ * El mapeo no se modifica: se ordena un arreglo de índices comparando los pesos en el mapeo, así
+ * la memoria propia del proceso es de `sizeof(Indice)` bytes por arista en vez de los 16 de una copia.
+ *
+ * @tparam Indice `uint32_t` si el archivo tiene menos de 2^32 aristas, `uint64_t` si no.
+ * @param archivo Archivo abierto, con aristas.
+ * @return Aristas del MST; vacío si una arista une nodos que no existen.
+ */
+template <class Indice>
+std::vector<AristaBinaria> kruskalPorIndices(const ArchivoMST& archivo){
+    size_t n = archivo.numPuntos();
+    size_t m = archivo.numAristas();
+    const AristaBinaria* aristas = archivo.aristas();
+    std::vector<AristaBinaria> result;
+
+    std::vector<Indice> orden(m);
+    for (size_t k=0; k<m; k++) orden[k] = k;
+    std::sort(orden.begin(), orden.end(),
+        [aristas](Indice a, Indice b){ return aristas[a].peso < aristas[b].peso; });
+
+    UnionFind uf(n);
+
+    for (Indice k : orden){
+        const AristaBinaria& a = aristas[k];
+        if (a.u >= n || a.v >= n){
+            std::cerr << "La arista " << k << " une nodos que no existen\n";
+            return {};
+        }
+        int raiz_x = uf.find(a.u);
+        int raiz_y = uf.find(a.v);
+
+        if (raiz_x != raiz_y) {
+            uf.union_(raiz_x, raiz_y);
+            result.push_back(a);
+            if (result.size() == n - 1) break; // cuando se encuentran n-1 aristas se termina
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Calcula el MST de un archivo binario.
+ *
+ * Si el archivo trae aristas, se aplica Kruskal con `kruskalPorIndices`, que ordena un arreglo de índices
+ * y lee las aristas del mapeo sin copiarlas. Las comparaciones leen el mapeo en desorden, así que las
+ * aristas deben caber en la memoria física; si no, conviene `kruskal_externo`. Si solo trae puntos, se
+ * calcula el MST euclidiano con `kruskal_geometrico`, que no necesita las O(N^2) aristas.
+ *
+ * @param archivo Archivo abierto.
+ * @return Aristas del MST, listas para escribirse con `escribirArchivoMST`; vacío si hay un error.
+ */
+std::vector<AristaBinaria> mstDeArchivo(const ArchivoMST& archivo){
+    if (archivo.numAristas() == 0){
+        std::vector<Node> V = archivo.nodos();
+        return aristasBinarias(kruskal_geometrico(V));
+    }
+    if (archivo.numAristas() <= UINT32_MAX) return kruskalPorIndices<uint32_t>(archivo);
+    return kruskalPorIndices<uint64_t>(archivo);
+}
@@ -0,0 +1,183 @@
+#pragma once
+#include <algorithm>    // std::max
+#include <cstddef>
+#include <new>
+#include <type_traits> // std::true_type
+#include <vector>
+
+/**
+ * @class Arena
+ * @brief Región de memoria dimensionada de antemano desde la que se reservan bloques avanzando un puntero.
+ *
+ * Liberar un bloque no hace nada, salvo que sea el último reservado; toda la memoria se recupera
+ * de una vez con `reiniciar`. Así un experimento que crea y destruye los mismos arreglos grandes
+ * en cada ejecución (copias de las aristas, buffers de ordenamiento, Union-Find) usa siempre las
+ * mismas páginas, en vez de pedirlas y devolverlas al sistema operativo cada vez.
+ *
+ * Si un bloque no cabe se entrega `nullptr` y quien lo pidió usa el heap; `desbordes` cuenta esos casos.
+ * No es segura para usarse desde varios hilos a la vez.
+ */
+class Arena {
+    char* memoria = nullptr;
+    size_t capacidad_ = 0;
+    size_t usado = 0;
+    size_t maximo = 0;
+    size_t desbordes_ = 0;
+
+public:
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Crea una arena de `bytes` bytes.
+     */
+    Arena(size_t bytes = 0){ reservarCapacidad(bytes); }
+
+    ~Arena(){ ::operator delete(memoria); }
+
+    /**
+     * @brief Asegura una capacidad de al menos `bytes` bytes; solo debe llamarse sin bloques vivos.
+     *
+     * Si la capacidad actual alcanza no se hace nada, así que dimensionarla para el tamaño más grande
+     * de un experimento evita volver a pedir memoria.
+     */
+    void reservarCapacidad(size_t bytes){
+        usado = 0;
+        if (bytes <= capacidad_) return;
+        ::operator delete(memoria);
+        memoria = (char*)::operator new(bytes);
+        capacidad_ = bytes;
+    }
+
+    /**
+     * @brief Reserva un bloque alineado.
+     *
+     * @param bytes Tamaño del bloque.
+     * @param alineacion Alineación, potencia de 2.
+     * @return El bloque, o `nullptr` si no cabe.
+     */
+    void* reservar(size_t bytes, size_t alineacion){
+        size_t inicio = (usado + alineacion - 1) & ~(alineacion - 1);
+        if (inicio + bytes > capacidad_ || inicio + bytes < inicio){
+            desbordes_++;
+            return nullptr;
+        }
+        usado = inicio + bytes;
+        maximo = std::max(maximo, usado);
+        return memoria + inicio;
+    }
+
+    /**
+     * @brief Libera un bloque; solo se recupera su espacio si es el último reservado.
+     */
+    void liberar(void* p, size_t bytes){
+        if ((char*)p + bytes == memoria + usado) usado = (char*)p - memoria;
+    }
+
+    /**
+     * @brief Indica si `p` apunta dentro de la arena.
+     */
+    bool contiene(const void* p) const {
+        return (const char*)p >= memoria && (const char*)p < memoria + capacidad_;
+    }
+
+    /**
+     * @brief Libera todos los bloques. Los vectores que aún los usen quedan inválidos.
+     */
+    void reiniciar(){ usado = 0; }
+
+    size_t capacidad() const { return capacidad_; }
+
+    /**
+     * @brief Máximo de bytes ocupados a la vez desde que se creó la arena.
+     */
+    size_t usoMaximo() const { return maximo; }
+
+    /**
+     * @brief Número de bloques que no cupieron y se pidieron al heap.
+     */
+    size_t desbordes() const { return desbordes_; }
+};
+
+/**
+ * @brief Arena en la que reservan los `AsignadorArena` creados en este hilo, o `nullptr` para usar el heap.
+ *
+ * Se activa con `AlcanceArena`. Es local a cada hilo, así que los hilos de trabajo de las variantes
+ * paralelas siempre usan el heap.
+ */
+thread_local Arena* arenaActiva = nullptr;
+
+/**
+ * @class AsignadorArena
+ * @brief Asignador compatible con la biblioteca estándar que reserva en una arena.
+ *
+ * Cada asignador recuerda la arena que estaba activa al crearse, por lo que un vector puede
+ * destruirse aunque la arena ya no esté activa. Sin arena, o si el bloque no cabe, usa el heap.
+ */
+template <class T>
+struct AsignadorArena {
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    Arena* arena;
+
+    AsignadorArena() : arena(arenaActiva) {}
+    template <class U>
+    AsignadorArena(const AsignadorArena<U>& otro) : arena(otro.arena) {}
+
+    T* allocate(size_t n){
+        if (arena){
+            void* p = arena->reservar(n * sizeof(T), alignof(T));
+            if (p) return (T*)p;
+        }
+        return (T*)::operator new(n * sizeof(T));
+    }
+
+    void deallocate(T* p, size_t n){
+        if (arena && arena->contiene(p)) arena->liberar(p, n * sizeof(T));
+        else ::operator delete(p);
+    }
+
+    template <class U>
+    bool operator==(const AsignadorArena<U>& otro) const { return arena == otro.arena; }
+    template <class U>
+    bool operator!=(const AsignadorArena<U>& otro) const { return arena != otro.arena; }
+};
+
+/**
+ * @brief Vector cuya memoria sale de la arena activa al crearlo.
+ */
+template <class T>
+using VectorArena = std::vector<T, AsignadorArena<T>>;
+
+/**
+ * @class AlcanceArena
+ * @brief Activa una arena mientras existe el objeto y al destruirlo la reinicia y restaura la anterior.
+ *
+ * Todo vector creado con `AsignadorArena` dentro del alcance debe destruirse antes de que este termine.
+ *
+ * ### Ejemplo de uso:
+ * @code
+ * Arena arena(64 << 20);
+ * {
+ *     AlcanceArena alcance(arena);
+ *     std::vector<Edge> mst = kruskal_array_Opti(G); // sus arreglos de trabajo salen de la arena
+ * }
+ * @endcode
+ */
+class AlcanceArena {
+    Arena& arena;
+    Arena* anterior;
+
+public:
+    AlcanceArena(const AlcanceArena&) = delete;
+    AlcanceArena& operator=(const AlcanceArena&) = delete;
+
+    AlcanceArena(Arena& a) : arena(a), anterior(arenaActiva) { arenaActiva = &arena; }
+
+    ~AlcanceArena(){
+        arenaActiva = anterior;
+        arena.reiniciar();
+    }
+};
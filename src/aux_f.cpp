@@ -1,4 +1,9 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "graph.cpp"
+#include "instrumentacion.cpp"
 
 //Funciones auxiliares
 
@@ -9,10 +14,11 @@
  *
  * @param edgesList Lista de aristas por imprimir
  */
-void printEdges(std::vector<Edge> edgesList){
+template <int D>
+void printEdges(std::vector<EdgeD<D>> edgesList){
     std::cout << "edges = [";
     for(size_t i = 0; i < edgesList.size(); ++i){
-        Edge E = edgesList[i];
+        EdgeD<D> E = edgesList[i];
         std::cout << "(" << E.n1->id << "," << E.n2->id << "," << E.peso << ")";
         if (i < edgesList.size() - 1) std::cout << ", ";
     }
@@ -29,13 +35,15 @@ void printEdges(std::vector<Edge> edgesList){
  * @param nodes Lista de nodos por imprimir
  * @param i Nombre de la variable por imprimir
  */
-void printNodes(std::vector<Node> nodes, int i=-1) {
+template <int D>
+void printNodes(std::vector<NodeD<D>> nodes, int i=-1) {
     if (i != -1)
         std::cout << "nodes" << i << " = [";
     else
         std::cout << "nodes = [";
     for (size_t i = 0; i < nodes.size(); ++i) {
-        std::cout << "(" << nodes[i].x << "," << nodes[i].y << ")";
+        std::cout << "(";
+        for (int k=0; k<D; k++) std::cout << nodes[i][k] << (k + 1 < D ? "," : ")");
         if (i < nodes.size() - 1) std::cout << ", ";
     }
     std::cout << "]" << std::endl;
@@ -46,58 +54,79 @@ void printNodes(std::vector<Node> nodes, int i=-1) {
  *
  * Esta función se utiliza para ordenar un conjunto de aristas en orden creciente
  * según su atributo `peso`. Se utiliza para ordenar arsitas en el algoritmo de Kruskal.
- *
- * @param a1 Primera arista a comparar.
- * @param a2 Segunda arista a comparar.
- * @return true si `a1` tiene menor peso que `a2`, false en caso contrario.
+ * Es un objeto función para que sirva con aristas de cualquier dimensión sin indicar su tipo
+ * (`std::sort(..., sortByWeight)`), y para que el compilador pueda expandir la comparación en línea.
  */
-bool sortByWeight(Edge a1, Edge a2){
-    return a1.peso<a2.peso;
-}
+struct ComparadorPesoAscendente {
+    /**
+     * @param a1 Primera arista a comparar.
+     * @param a2 Segunda arista a comparar.
+     * @return true si `a1` tiene menor peso que `a2`, false en caso contrario.
+     */
+    template <class Arista>
+    bool operator()(const Arista& a1, const Arista& a2) const {
+        return a1.peso<a2.peso;
+    }
+};
+constexpr ComparadorPesoAscendente sortByWeight{};
 
 /**
  * @brief Comparador para ordenar aristas por peso en orden descendente.
  *
  * Esta función permite ordenar aristas de mayor a menor peso, lo cual es útil
  * cuando se utiliza una estructura como un heap.
- *
- * @param a1 Primera arista a comparar.
- * @param a2 Segunda arista a comparar.
- * @return true si `a1` tiene mayor peso que `a2`, false en caso contrario.
  */
-bool sortByWeightHeap(Edge a1, Edge a2){
-    return a1.peso>a2.peso;
-}
+struct ComparadorPesoDescendente {
+    /**
+     * @param a1 Primera arista a comparar.
+     * @param a2 Segunda arista a comparar.
+     * @return true si `a1` tiene mayor peso que `a2`, false en caso contrario.
+     */
+    template <class Arista>
+    bool operator()(const Arista& a1, const Arista& a2) const {
+        return a1.peso>a2.peso;
+    }
+};
+constexpr ComparadorPesoDescendente sortByWeightHeap{};
 
 /**
- * @brief Verifica si cuatro conjuntos de aristas tienen el mismo peso total.
+ * @brief Compara dos pesos totales de MST admitiendo el error de redondeo de sumarlos.
  *
- * Esta función compara la suma de los pesos de las aristas contenidas en
- * cuatro vectores distintos. Retorna `true` si el peso total de los cuatro
- * conjuntos es idéntico.
+ * Dos MST del mismo grafo tienen el mismo peso, pero si hay pesos repetidos pueden tener aristas
+ * distintas, y aunque tengan las mismas cada variante las suma en otro orden. Sumar `terminos` pesos
+ * no negativos tiene un error relativo de a lo más (terminos - 1) ε, así que se acepta el doble de eso.
  *
- * @param A Primer conjunto de aristas.
- * @param B Segundo conjunto de aristas.
- * @param C Tercer conjunto de aristas.
- * @param D Cuarto conjunto de aristas.
- * @return true si todos los conjuntos tienen el mismo peso total, false en caso contrario.
+ * @param a Primer peso total.
+ * @param b Segundo peso total.
+ * @param terminos Número de aristas sumadas en cada peso.
+ * @return true si la diferencia se explica por el redondeo, false en caso contrario.
  */
-bool mismosPesos(const std::vector<Edge>& A,
-    const std::vector<Edge>& B,
-    const std::vector<Edge>& C,
-    const std::vector<Edge>& D) {
-
-    auto suma = [](const std::vector<Edge>& edges) -> double {
-        double total = 0;
-        for (const Edge& e : edges) total += e.peso;
-        return total;
-    };
+bool pesosIguales(double a, double b, size_t terminos){
+    double tolerancia = 2.0 * std::max<size_t>(terminos, 1) * std::numeric_limits<double>::epsilon();
+    return std::abs(a - b) <= tolerancia * std::max(std::abs(a), std::abs(b));
+}
 
-    double pesoA = suma(A);
-    double pesoB = suma(B);
-    double pesoC = suma(C);
-    double pesoD = suma(D);
 
-    return (pesoA == pesoB) && (pesoB == pesoC) && (pesoC == pesoD);
+/**
+ * @brief Reparte el rango [0, total) en bloques contiguos y procesa cada bloque en un hilo.
+ *
+ * Llama a `f(desde, hasta, t)` para el bloque t y espera a que terminen todos los hilos.
+ * Con un solo hilo se llama directamente, sin crear hilos.
+ *
+ * @param hilos Número de hilos (y de bloques) a usar.
+ * @param total Tamaño del rango.
+ * @param f Función que procesa un bloque.
+ */
+template <class F>
+void enParalelo(int hilos, size_t total, F f){
+    if (hilos < 1) hilos = 1;
+    if (hilos == 1){
+        f((size_t)0, total, 0);
+        return;
+    }
+    std::vector<std::thread> trabajadores;
+    for (int t=0; t<hilos; t++){
+        trabajadores.push_back(std::thread(f, total * t / hilos, total * (t + 1) / hilos, t));
+    }
+    for (std::thread& t : trabajadores) t.join();
 }
-
@@ -0,0 +1,426 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <sys/resource.h> // getrusage
+#include "kruskal.cpp"
+#include "prim.cpp"
+#include "geometrico.cpp"
+#include "compactEdges.cpp"
+#include "boruvka.cpp"
+#include "generador.cpp"
+#include "precision.cpp"
+#include "aproximado.cpp"
+#include "verificacion.cpp"
+
+/**
+ * @brief Una variante de árbol cobertor mínimo que el benchmark puede ejecutar.
+ *
+ * Las variantes que necesitan las aristas del grafo completo definen `completo`; las que
+ * solo usan los nodos definen `implicito` y pueden ejecutarse con tamaños en los que `Graph` no cabe en memoria.
+ * Las implícitas que igual crean sus O(N^2) aristas, en un formato más compacto, lo indican con `creaAristas`
+ * y solo corren hasta `expMaxPrecision`. Las variantes que usan pesos de menor precisión definen una
+ * tolerancia para su peso total.
+ */
+struct Variante {
+    std::string nombre;
+    std::function<std::vector<Edge>(Graph&)> completo;
+    std::function<std::vector<Edge>(ImplicitGraph&)> implicito;
+    double tolerancia = 0;  // error relativo aceptado en el peso del MST; 0 si la variante es exacta
+    bool creaAristas = false;  // la variante implícita crea sus propias aristas
+};
+
+/**
+ * @brief Parámetros de un benchmark.
+ */
+struct ConfiguracionBenchmark {
+    int expMin = 5;            // se prueban N = 2^i con i en [expMin, expMax]
+    int expMax = 16;
+    int expMaxCompleto = 13;   // sobre este exponente solo corren las variantes implícitas
+    int expMaxPrecision = 14;  // sobre este exponente no corren las implícitas que crean sus aristas (de 12 bytes)
+    int repeticiones = 5;      // mediciones por variante y tamaño
+    int calentamiento = 1;     // ejecuciones no medidas de cada variante antes de medir
+    unsigned semilla = 42;     // semilla de los puntos y del orden de las variantes
+    DistribucionPuntos distribucion = PUNTOS_UNIFORMES;
+    int hilos = 1;             // hilos para construir el grafo y para las variantes paralelas
+    bool usarArena = true;     // reutiliza la memoria del grafo y de los arreglos de trabajo entre ejecuciones
+#ifdef INSTRUMENTACION
+    // Las columnas cambian con la instrumentación, así que se usan otros archivos
+    std::string archivoResumen = "./csv/benchmark_instrumentado.csv";
+    std::string archivoCrudo = "./csv/benchmark_instrumentado_crudo.csv";
+#else
+    std::string archivoResumen = "./csv/benchmark.csv";
+    std::string archivoCrudo = "./csv/benchmark_crudo.csv";
+#endif
+};
+
+/**
+ * @brief Resumen estadístico de un conjunto de mediciones.
+ */
+struct Estadisticas {
+    double mediana = 0;
+    double p95 = 0;
+    double promedio = 0;
+    double desviacion = 0;  // desviación estándar muestral
+    double minimo = 0;
+};
+
+/**
+ * @brief Calcula mediana, percentil 95 (por rango más cercano), promedio, desviación estándar y mínimo.
+ *
+ * @param muestras Mediciones; se copian para ordenarlas.
+ * @return Estadísticas de las mediciones, todas 0 si no hay mediciones.
+ */
+Estadisticas calcularEstadisticas(std::vector<double> muestras){
+    Estadisticas e;
+    size_t m = muestras.size();
+    if (m == 0) return e;
+    std::sort(muestras.begin(), muestras.end());
+
+    e.minimo = muestras[0];
+    e.mediana = (m % 2 == 1) ? muestras[m / 2] : (muestras[m / 2 - 1] + muestras[m / 2]) / 2;
+    e.p95 = muestras[(size_t)std::ceil(0.95 * m) - 1];
+
+    for (double x : muestras) e.promedio += x;
+    e.promedio /= m;
+    if (m > 1){
+        for (double x : muestras) e.desviacion += (x - e.promedio) * (x - e.promedio);
+        e.desviacion = std::sqrt(e.desviacion / (m - 1));
+    }
+    return e;
+}
+
+/**
+ * @brief Lista de todas las variantes disponibles.
+ *
+ * @param hilos Hilos que usan las variantes paralelas.
+ * @return Vector con las variantes, en el orden en que se reportan.
+ */
+std::vector<Variante> variantesRegistradas(int hilos){
+    std::vector<Variante> v;
+    v.push_back({"kruskal_array", [](Graph& G){ return kruskal_array(G); }, nullptr});
+    v.push_back({"kruskal_array_uf", [](Graph& G){ return kruskal_array_Opti(G); }, nullptr});
+    v.push_back({"kruskal_heap", [](Graph& G){ return kruskal_heap(G); }, nullptr});
+    v.push_back({"kruskal_heap_uf", [](Graph& G){ return kruskal_heap_Opti(G); }, nullptr});
+    v.push_back({"prim_implicito", nullptr, [](ImplicitGraph& G){ return prim_denso(G); }});
+    v.push_back({"kruskal_geometrico", nullptr, [](ImplicitGraph& G){ return kruskal_geometrico(G); }});
+    v.push_back({"kruskal_heap_compacto", [](Graph& G){
+        MedidorFase medidor;
+        CompactEdges E(G.V);
+        medidor.terminar(&TiemposFases::copia);
+        return kruskal_heap_compacto(E, G.V.size()).aEdges(G.V);
+    }, nullptr});
+    v.push_back({"kruskal_array_compacto", [](Graph& G){
+        MedidorFase medidor;
+        CompactEdges E(G.V);
+        medidor.terminar(&TiemposFases::copia);
+        return kruskal_array_compacto(E, G.V.size()).aEdges(G.V);
+    }, nullptr});
+    v.push_back({"kruskal_array_uf_paralelo", [hilos](Graph& G){ return kruskal_array_Opti(G, ORDEN_PARALELO, hilos); }, nullptr});
+    v.push_back({"kruskal_array_uf_radix", [hilos](Graph& G){ return kruskal_array_Opti(G, ORDEN_RADIX, hilos); }, nullptr});
+    v.push_back({"kruskal_array_uf_parcial", [](Graph& G){ return kruskal_array_Opti(G, ORDEN_PARCIAL, 1); }, nullptr});
+    v.push_back({"kruskal_filter", [](Graph& G){ return kruskal_filter(G); }, nullptr});
+    v.push_back({"kruskal_heap_uf_4ario", [](Graph& G){ return kruskal_heap_Opti(G, HEAP_4ARIO); }, nullptr});
+    v.push_back({"kruskal_heap_uf_8ario", [](Graph& G){ return kruskal_heap_Opti(G, HEAP_8ARIO); }, nullptr});
+    v.push_back({"kruskal_filter_paralelo", [hilos](Graph& G){ return kruskal_filter_paralelo(G, hilos); }, nullptr});
+    v.push_back({"boruvka_paralelo", [hilos](Graph& G){ return boruvka_paralelo(G, hilos); }, nullptr});
+    v.push_back({"kruskal_array_uf_mitades", [](Graph& G){
+        return kruskal_array_uf<UnionFindPolitica<COMPRESION_MITADES>>(G, ORDEN_STD, 1);
+    }, nullptr});
+    v.push_back({"kruskal_array_uf_division", [](Graph& G){
+        return kruskal_array_uf<UnionFindPolitica<DIVISION_CAMINOS>>(G, ORDEN_STD, 1);
+    }, nullptr});
+    v.push_back({"kruskal_array_uf_rango_unico", [](Graph& G){
+        return kruskal_array_uf<UnionFindPolitica<COMPRESION_COMPLETA, UNION_RANGO, true>>(G, ORDEN_STD, 1);
+    }, nullptr});
+    v.push_back({"kruskal_cubetas", [](Graph& G){ return kruskal_cubetas(G); }, nullptr});
+    v.push_back({"kruskal_float", nullptr, [hilos](ImplicitGraph& G){ return kruskal_precision<float>(G.V, hilos); }, 1e-6, true});
+    v.push_back({"kruskal_entero", nullptr, [hilos](ImplicitGraph& G){ return kruskal_precision<uint32_t>(G.V, hilos); }, 1e-6, true});
+    // El número es el error máximo del peso total, en porcentaje
+    v.push_back({"mst_aproximado_1", nullptr, [](ImplicitGraph& G){ return mst_aproximado(G, 0.01); }, 0.01});
+    v.push_back({"mst_aproximado_10", nullptr, [](ImplicitGraph& G){ return mst_aproximado(G, 0.1); }, 0.1});
+    return v;
+}
+
+/**
+ * @brief Suma de los pesos de un conjunto de aristas.
+ */
+double pesoTotal(const std::vector<Edge>& edges){
+    double total = 0;
+    for (const Edge& e : edges) total += e.peso;
+    return total;
+}
+
+/**
+ * @brief Bytes de arena que necesita la variante que más memoria de trabajo usa con N nodos.
+ *
+ * Es el caso de ordenar una copia de las aristas con un buffer auxiliar: dos arreglos de `Edge`,
+ * más los dos arreglos del Union-Find y un margen para los bloques pequeños.
+ */
+size_t bytesArena(size_t N){
+    size_t m = N * (N - 1) / 2;
+    return 2 * m * sizeof(Edge) + 2 * N * sizeof(int) + (4 << 20);
+}
+
+/**
+ * @brief Ejecuta un benchmark de las variantes de árbol cobertor mínimo.
+ *
+ * Para cada tamaño N = 2^i:
+ * 1. Se generan N puntos con `generarPuntos`, con una semilla derivada de `semilla`, i y la repetición;
+ *    así cada repetición usa otros puntos pero el benchmark completo es reproducible.
+ * 2. Se ejecuta cada variante `calentamiento` veces sin medir.
+ * 3. En cada repetición se genera un grafo nuevo y se ejecutan las variantes en un orden aleatorio,
+ *    midiendo el tiempo total y el de cada etapa (copia, orden/heap, Union-Find). Con `usarArena` el
+ *    grafo nuevo reutiliza el arreglo de aristas del anterior y los arreglos de trabajo de cada variante
+ *    salen de una arena que se reinicia después de ejecutarla.
+ * 4. Se verifica que todas las variantes exactas obtengan el mismo peso total, salvo el redondeo de la
+ *    suma (ver `pesosIguales`), y que las de menor precisión no se alejen de él más que su tolerancia.
+ *    Si no, con el grafo completo se verifica el MST de la referencia con `verificarMST` para indicar cuál falla.
+ *
+ * ### CSV generados
+ * `archivoCrudo` guarda una línea por ejecución medida:
+ * ```
+ * N, distribucion, repeticion, posicion, variante, total, copia, orden, union_find, aristas_ordenadas
+ * ```
+ * `archivoResumen` guarda una línea por variante y tamaño (la construcción del grafo se reporta como la variante `construccion`):
+ * ```
+ * N, distribucion, variante, repeticiones, mediana, p95, promedio, desviacion, minimo, copia_mediana, orden_mediana, union_find_mediana, aristas_ordenadas_mediana
+ * ```
+ * `aristas_ordenadas` es el número de aristas que la variante ordenó completas (ver `contarOrdenadas`).
+ * Si se compiló con `-DINSTRUMENTACION`, ambos archivos agregan al final una columna por contador
+ * (ver `columnasContadores`): su valor en el crudo y su mediana en el resumen.
+ *
+ * @param config Parámetros del benchmark.
+ */
+void ejecutarBenchmark(const ConfiguracionBenchmark& config){
+    std::vector<Variante> variantes = variantesRegistradas(config.hilos);
+    std::mt19937_64 genOrden(config.semilla);
+    size_t numContadores = columnasContadores().size();
+
+    std::ofstream crudo(config.archivoCrudo, std::ios::app);
+    std::ofstream resumen(config.archivoResumen, std::ios::app);
+    if (!crudo || !resumen){
+        std::cerr << "No se pudo escribir en '" << config.archivoCrudo << "' o '" << config.archivoResumen << "'\n";
+        return;
+    }
+
+    // Memoria que se reutiliza entre ejecuciones: el arreglo de aristas del grafo y una arena para los
+    // arreglos de trabajo de cada variante (copias de las aristas, buffers de ordenamiento, Union-Find)
+    Arena arena;
+    std::vector<Edge> espacioAristas;
+
+    for (int i=config.expMin; i<=config.expMax; i++){
+        int N = 1 << i;
+        bool completo = i <= config.expMaxCompleto;
+        bool conArena = config.usarArena && completo;
+        if (conArena) arena.reservarCapacidad(bytesArena(N));
+
+        // Variantes que se pueden ejecutar con este tamaño
+        std::vector<int> activas;
+        for (int k=0; k<variantes.size(); k++){
+            const Variante& var = variantes[k];
+            if (completo || (var.implicito && (!var.creaAristas || i <= config.expMaxPrecision))) activas.push_back(k);
+        }
+
+        std::map<std::string, std::vector<double>> total, copia, orden, unionFind, ordenadas;
+        std::map<std::string, std::vector<std::vector<double>>> contadores; // [variante][contador][repeticion]
+        std::cout << "\n--- N = " << N << ", puntos " << nombreDistribucion(config.distribucion) << (completo ? "" : " (solo variantes implícitas)") << " ---\n";
+
+        for (int rep=-config.calentamiento; rep<config.repeticiones; rep++){
+            bool medir = rep >= 0;
+            uint64_t semillaPuntos = config.semilla * 1000003 + (uint64_t)i * 1009 + (rep + config.calentamiento);
+            std::vector<Node> nodos = generarPuntos(N, semillaPuntos, config.distribucion, config.hilos);
+
+            auto inicioConstruccion = std::chrono::steady_clock::now();
+            ImplicitGraph GI(nodos);
+            std::unique_ptr<Graph> G(completo ? new Graph(nodos, config.hilos, std::move(espacioAristas)) : nullptr);
+            double tiempoConstruccion = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicioConstruccion).count();
+            if (medir) total["construccion"].push_back(tiempoConstruccion);
+
+            std::shuffle(activas.begin(), activas.end(), genOrden);
+            std::vector<std::pair<const Variante*, double>> pesos; // se verifican al terminar la repetición
+            std::vector<Edge> arbolReferencia; // MST de la primera variante exacta, para saber cuál falla
+
+            for (int posicion=0; posicion<activas.size(); posicion++){
+                const Variante& var = variantes[activas[posicion]];
+                TiemposFases fases;
+                fasesActivas = &fases;
+                std::optional<AlcanceArena> alcance;
+                if (conArena) alcance.emplace(arena);
+                auto inicio = std::chrono::steady_clock::now();
+                std::vector<Edge> MST = var.implicito ? var.implicito(GI) : var.completo(*G);
+                double tiempo = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+                alcance.reset();
+                fasesActivas = nullptr;
+
+                if (MST.size() != N - 1){
+                    std::cerr << "Error: " << var.nombre << " obtuvo " << MST.size() << " aristas (N = " << N << ")\n";
+                    exit(1);
+                }
+                pesos.push_back({&var, pesoTotal(MST)});
+                if (var.tolerancia == 0 && arbolReferencia.empty()) arbolReferencia = MST;
+
+                if (!medir) continue;
+                total[var.nombre].push_back(tiempo);
+                copia[var.nombre].push_back(fases.copia);
+                orden[var.nombre].push_back(fases.orden);
+                unionFind[var.nombre].push_back(fases.unionFind);
+                ordenadas[var.nombre].push_back(fases.aristasOrdenadas);
+                crudo << N << "," << nombreDistribucion(config.distribucion) << "," << rep << "," << posicion << "," << var.nombre << ","
+                      << tiempo << "," << fases.copia << "," << fases.orden << "," << fases.unionFind << "," << fases.aristasOrdenadas;
+                std::vector<double> valores = valoresContadores(fases);
+                contadores[var.nombre].resize(numContadores);
+                for (size_t c=0; c<numContadores; c++){
+                    crudo << "," << valores[c];
+                    contadores[var.nombre][c].push_back(valores[c]);
+                }
+                crudo << "\n";
+            }
+
+            // La referencia es la primera variante exacta
+            const std::pair<const Variante*, double>* referencia = nullptr;
+            for (const auto& p : pesos) if (!referencia && p.first->tolerancia == 0) referencia = &p;
+            for (const auto& p : pesos){
+                if (!referencia) break;
+                bool iguales = p.first->tolerancia == 0 ? pesosIguales(p.second, referencia->second, N - 1)
+                                                        : std::abs(p.second - referencia->second) <= p.first->tolerancia * referencia->second;
+                if (!iguales){
+                    std::cerr << "Error: " << p.first->nombre << " obtuvo peso " << p.second << " y "
+                              << referencia->first->nombre << " obtuvo " << referencia->second << " (N = " << N << ")\n";
+                    // Todos los MST pesan lo mismo: si la referencia es un MST, la que falla es la otra
+                    if (G){
+                        CertificadoMST certificado = verificarMST(G->E, N, arbolReferencia);
+                        std::cerr << (certificado.valido ? p.first->nombre + " no es un MST"
+                                                         : referencia->first->nombre + " no es un MST: " + certificado.motivo) << "\n";
+                    }
+                    exit(1);
+                }
+            }
+            if (G && config.usarArena) espacioAristas = G->liberarAristas();
+        }
+
+        // Resumen del tamaño
+        struct rusage uso;
+        getrusage(RUSAGE_SELF, &uso);
+        std::cout << "memoria máxima del proceso: " << uso.ru_maxrss / 1024 << " MB";
+        if (conArena){
+            std::cout << ", arena: " << (arena.usoMaximo() + (1 << 20) - 1) / (1 << 20) << " de " << arena.capacidad() / (1 << 20)
+                      << " MB, " << arena.desbordes() << " bloques fuera de la arena";
+        }
+        std::cout << "\n";
+        std::cout << std::left << std::setw(30) << "variante" << std::right
+                  << std::setw(12) << "mediana" << std::setw(12) << "p95" << std::setw(12) << "desv" << "\n";
+        std::vector<std::string> nombres = {"construccion"};
+        for (const Variante& var : variantes){
+            if (total.count(var.nombre)) nombres.push_back(var.nombre);
+        }
+        for (const std::string& nombre : nombres){
+            Estadisticas e = calcularEstadisticas(total[nombre]);
+            Estadisticas c = calcularEstadisticas(copia[nombre]);
+            Estadisticas o = calcularEstadisticas(orden[nombre]);
+            Estadisticas u = calcularEstadisticas(unionFind[nombre]);
+            Estadisticas a = calcularEstadisticas(ordenadas[nombre]);
+            std::cout << std::left << std::setw(30) << nombre << std::right
+                      << std::setw(12) << e.mediana << std::setw(12) << e.p95 << std::setw(12) << e.desviacion << "\n";
+            resumen << N << "," << nombreDistribucion(config.distribucion) << "," << nombre << "," << total[nombre].size() << ","
+                    << e.mediana << "," << e.p95 << "," << e.promedio << "," << e.desviacion << "," << e.minimo << ","
+                    << c.mediana << "," << o.mediana << "," << u.mediana << "," << a.mediana;
+            contadores[nombre].resize(numContadores);
+            for (size_t k=0; k<numContadores; k++){
+                resumen << "," << calcularEstadisticas(contadores[nombre][k]).mediana;
+            }
+            resumen << "\n";
+        }
+    }
+}
+
+
+/**
+ * @brief Compara las cuatro variantes de Kruskal y el Kruskal geométrico sobre puntos de D coordenadas.
+ *
+ * Para cada N = 2^i genera N puntos de D coordenadas con `generarPuntos`, ejecuta las variantes
+ * `repeticiones` veces y muestra la mediana de sus tiempos. Las cuatro variantes sobre el grafo completo
+ * solo corren hasta `expMaxCompleto`. Se verifica que todas obtengan el mismo peso que `kruskal_geometrico`.
+ *
+ * @tparam D Número de coordenadas de los puntos.
+ * @param config Parámetros del benchmark; se usan los exponentes, las repeticiones, la semilla, la distribución y los hilos.
+ * @return false si alguna variante obtiene otro peso.
+ */
+template <int D>
+bool ejecutarBenchmarkDimension(const ConfiguracionBenchmark& config){
+    typedef std::function<std::vector<EdgeD<D>>(GraphD<D>&)> VarianteCompleta;
+    std::vector<std::pair<std::string, VarianteCompleta>> variantes = {
+        {"kruskal_array", [](GraphD<D>& G){ return kruskal_array(G); }},
+        {"kruskal_array_uf", [](GraphD<D>& G){ return kruskal_array_Opti(G); }},
+        {"kruskal_heap", [](GraphD<D>& G){ return kruskal_heap(G); }},
+        {"kruskal_heap_uf", [](GraphD<D>& G){ return kruskal_heap_Opti(G); }},
+    };
+
+    for (int i=config.expMin; i<=config.expMax; i++){
+        int N = 1 << i;
+        bool completo = i <= config.expMaxCompleto;
+        std::cout << "\n--- N = " << N << ", D = " << D << ", puntos " << nombreDistribucion(config.distribucion)
+                  << (completo ? "" : " (solo kruskal_geometrico)") << " ---\n";
+        std::vector<std::string> nombres = {"kruskal_geometrico"};
+        if (completo) for (const auto& v : variantes) nombres.push_back(v.first);
+        std::map<std::string, std::vector<double>> tiempos;
+
+        for (int rep=0; rep<config.repeticiones; rep++){
+            std::vector<NodeD<D>> nodos = generarPuntos<D>(N, config.semilla * 1000003 + (uint64_t)i * 1009 + rep, config.distribucion, config.hilos);
+            ImplicitGraphD<D> GI(nodos);
+            std::unique_ptr<GraphD<D>> G(completo ? new GraphD<D>(nodos, config.hilos) : nullptr);
+
+            double referencia = 0;
+            for (const std::string& nombre : nombres){
+                auto inicio = std::chrono::steady_clock::now();
+                std::vector<EdgeD<D>> MST;
+                if (nombre == "kruskal_geometrico") MST = kruskal_geometrico(GI);
+                else for (const auto& v : variantes) if (v.first == nombre) MST = v.second(*G);
+                tiempos[nombre].push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count());
+
+                double peso = 0;
+                for (const EdgeD<D>& e : MST) peso += e.peso;
+                if (nombre == nombres[0]) referencia = peso;
+                if (MST.size() != N - 1 || !pesosIguales(peso, referencia, N - 1)){
+                    std::cerr << "Error: " << nombre << " obtuvo " << MST.size() << " aristas de peso " << peso
+                              << " y " << nombres[0] << " obtuvo " << referencia << " (N = " << N << ", D = " << D << ")\n";
+                    return false;
+                }
+            }
+        }
+
+        std::cout << std::left << std::setw(30) << "variante" << std::right << std::setw(12) << "mediana" << "\n";
+        for (const std::string& nombre : nombres){
+            std::cout << std::left << std::setw(30) << nombre << std::right
+                      << std::setw(12) << calcularEstadisticas(tiempos[nombre]).mediana << "\n";
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Ejecuta `ejecutarBenchmarkDimension` con una dimensión elegida en tiempo de ejecución.
+ *
+ * La dimensión es un parámetro de plantilla, así que solo están compiladas algunas: 2, 3, 4, 8 y 16.
+ *
+ * @return false si la dimensión no está compilada o si alguna variante obtiene otro peso.
+ */
+bool ejecutarBenchmarkDimension(int dimension, const ConfiguracionBenchmark& config){
+    switch (dimension){
+        case 2: return ejecutarBenchmarkDimension<2>(config);
+        case 3: return ejecutarBenchmarkDimension<3>(config);
+        case 4: return ejecutarBenchmarkDimension<4>(config);
+        case 8: return ejecutarBenchmarkDimension<8>(config);
+        case 16: return ejecutarBenchmarkDimension<16>(config);
+        default:
+            std::cerr << "Dimensión no compilada: " << dimension << " (se puede usar 2, 3, 4, 8 o 16)\n";
+            return false;
+    }
+}
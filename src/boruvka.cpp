@@ -0,0 +1,112 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include "kruskal.cpp"
+
+/**
+ * @brief Compara dos aristas con un orden total: por peso, y en caso de empate por ids de sus nodos.
+ *
+ * Con un orden total las aristas mínimas de todas las componentes nunca forman un ciclo.
+ */
+inline bool aristaMenor(const Edge& a, const Edge& b){
+    if (a.peso != b.peso) return a.peso < b.peso;
+    if (a.n1->id != b.n1->id) return a.n1->id < b.n1->id;
+    return a.n2->id < b.n2->id;
+}
+
+/**
+ * @brief Implementación paralela del algoritmo de Borůvka.
+ *
+ * Esta función construye un árbol de expansión mínima (MST) a partir de un grafo no dirigido.
+ * En cada ronda:
+ * 1. Cada hilo recorre un bloque de las aristas vivas y guarda, para cada componente, la arista
+ *    más liviana que sale de ella.
+ * 2. Se combinan los resultados de los hilos, repartiendo las componentes entre ellos.
+ * 3. Cada hilo une las componentes de su bloque con su arista mínima en un `ConcurrentUnionFind`.
+ * 4. Se descartan en paralelo las aristas que quedaron dentro de una misma componente.
+ *
+ * Cada ronda al menos reduce a la mitad el número de componentes, así que hay O(log N) rondas.
+ * Las aristas resultantes se ordenan por peso, igual que las de `kruskal_array_Opti`.
+ *
+ * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @param hilos Número de hilos a usar.
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+std::vector<Edge> boruvka_paralelo(Graph& G, int hilos){
+    const uint32_t NINGUNA = UINT32_MAX;
+    if (hilos < 1) hilos = 1;
+
+    MedidorFase medidor;
+    VectorArena<Edge> edges(G.E.begin(), G.E.end()); // aristas vivas, se van filtrando en cada ronda
+    medidor.terminar(&TiemposFases::copia);
+
+    int n = G.V.size();
+    std::vector<Edge> result;
+    if (n < 2) return result;
+
+    ConcurrentUnionFind uf(n);
+    std::vector<int> componente(n);
+    std::vector<std::vector<uint32_t>> mejorLocal(hilos, std::vector<uint32_t>(n, NINGUNA));
+    std::vector<std::vector<double>> pesoLocal(hilos, std::vector<double>(n)); // peso de mejorLocal, evita leer la arista
+    std::vector<uint32_t> mejor(n);
+    std::vector<std::vector<Edge>> elegidas(hilos);
+
+    while (result.size() < n - 1 && !edges.empty()){
+        enParalelo(hilos, n, [&](size_t desde, size_t hasta, int){
+            for (size_t i=desde; i<hasta; i++) componente[i] = uf.find(i);
+        });
+
+        // 1. Arista mínima de cada componente, por hilo
+        enParalelo(hilos, edges.size(), [&](size_t desde, size_t hasta, int t){
+            std::vector<uint32_t>& local = mejorLocal[t];
+            std::vector<double>& peso = pesoLocal[t];
+            std::fill(local.begin(), local.end(), NINGUNA);
+            std::fill(peso.begin(), peso.end(), std::numeric_limits<double>::infinity());
+            for (size_t k=desde; k<hasta; k++){
+                const Edge& e = edges[k];
+                int cx = componente[e.n1->id];
+                int cy = componente[e.n2->id];
+                // Solo en caso de empate hay que mirar la arista guardada
+                if (e.peso < peso[cx] || (e.peso == peso[cx] && aristaMenor(e, edges[local[cx]]))){
+                    local[cx] = k;
+                    peso[cx] = e.peso;
+                }
+                if (e.peso < peso[cy] || (e.peso == peso[cy] && aristaMenor(e, edges[local[cy]]))){
+                    local[cy] = k;
+                    peso[cy] = e.peso;
+                }
+            }
+        });
+
+        // 2. Se combinan los mínimos de los hilos
+        enParalelo(hilos, n, [&](size_t desde, size_t hasta, int){
+            for (size_t c=desde; c<hasta; c++){
+                uint32_t m = NINGUNA;
+                for (int h=0; h<hilos; h++){
+                    uint32_t k = mejorLocal[h][c];
+                    if (k != NINGUNA && (m == NINGUNA || aristaMenor(edges[k], edges[m]))) m = k;
+                }
+                mejor[c] = m;
+            }
+        });
+
+        // 3. Se contraen las componentes; si dos eligen la misma arista solo una unión tiene efecto
+        enParalelo(hilos, n, [&](size_t desde, size_t hasta, int t){
+            elegidas[t].clear();
+            for (size_t c=desde; c<hasta; c++){
+                if (mejor[c] == NINGUNA) continue;
+                const Edge& e = edges[mejor[c]];
+                if (uf.union_(e.n1->id, e.n2->id)) elegidas[t].push_back(e);
+            }
+        });
+        size_t antes = result.size();
+        for (int t=0; t<hilos; t++) result.insert(result.end(), elegidas[t].begin(), elegidas[t].end());
+        if (result.size() == antes) break; // el grafo no es conexo
+
+        // 4. Se descartan las aristas internas de las componentes
+        edges.resize(filtrarPesadas(edges, 0, edges.size(), uf, hilos));
+    }
+
+    std::sort(result.begin(), result.end(), sortByWeight);
+    return result;
+}
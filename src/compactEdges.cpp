@@ -0,0 +1,205 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>    // std::sort
+#include <functional>   // std::greater
+#include <queue>
+#include "UnionFind.cpp"
+#include "arena.cpp"
+#include "aux_f.cpp"
+
+/**
+ * @class CompactEdges
+ * @brief Lista de aristas guardada como arreglos separados (structure of arrays).
+ *
+ * Cada arista se guarda como dos índices de 32 bits (`u`, `v`) y su peso, en tres arreglos contiguos.
+ * Ocupa 16 bytes por arista en vez de los 24 de `Edge`, y los algoritmos leen los ids de los nodos
+ * directamente, sin pasar por un puntero a `Graph::V`. Los arreglos salen de la arena activa al crear
+ * la lista, si hay una.
+ */
+class CompactEdges {
+public:
+    VectorArena<uint32_t> u;    // id del primer nodo de cada arista
+    VectorArena<uint32_t> v;    // id del segundo nodo de cada arista
+    VectorArena<double> peso;   // cuadrado de la distancia euclidiana
+
+    /**
+     * @brief Crea una lista de aristas vacía.
+     */
+    CompactEdges() {}
+
+    /**
+     * @brief Copia las aristas de un grafo completo, en el mismo orden que `G.E`.
+     *
+     * @param G Grafo de entrada.
+     */
+    CompactEdges(const Graph& G) {
+        reserve(G.E.size());
+        for (const Edge& e : G.E) push_back(e.n1->id, e.n2->id, e.peso);
+    }
+
+    /**
+     * @brief Crea las N(N-1)/2 aristas posibles entre los nodos, sin pasar por `Graph`.
+     *
+     * Las aristas quedan en el mismo orden en que las crea el constructor de `Graph`.
+     *
+     * @param V Nodos del grafo; `V[i].id` debe ser `i`.
+     */
+    CompactEdges(const std::vector<Node>& V) {
+        size_t n = V.size();
+        reserve(n * (n - 1) / 2);
+        for (size_t i=0; i<n; i++){
+            for (size_t j=i+1; j<n; j++) push_back(i, j, distanciaCuadrada(&V[i], &V[j]));
+        }
+    }
+
+    /**
+     * @brief Número de aristas guardadas.
+     */
+    size_t size() const { return peso.size(); }
+
+    /**
+     * @brief Reserva espacio para `m` aristas en los tres arreglos.
+     */
+    void reserve(size_t m){
+        u.reserve(m);
+        v.reserve(m);
+        peso.reserve(m);
+    }
+
+    /**
+     * @brief Agrega la arista (a, b) con peso w al final de la lista.
+     */
+    void push_back(uint32_t a, uint32_t b, double w){
+        u.push_back(a);
+        v.push_back(b);
+        peso.push_back(w);
+    }
+
+    /**
+     * @brief Ordena las aristas por peso en orden ascendente, en su lugar.
+     *
+     * Se ordena una permutación de índices de 32 bits (4 bytes por arista, en vez de copiar los
+     * 16 de cada arista) y luego se aplica a `u`, `v` y `peso` recorriendo sus ciclos: cada arista
+     * se mueve una sola vez y la permutación marca las posiciones que ya quedaron en su lugar.
+     * Requiere menos de 2^32 aristas, como el índice de `kruskal_heap_compacto`.
+     */
+    void ordenar(){
+        size_t m = size();
+        VectorArena<uint32_t> orden(m);
+        for (size_t k=0; k<m; k++) orden[k] = k;
+        std::sort(orden.begin(), orden.end(), [this](uint32_t a, uint32_t b){ return peso[a] < peso[b]; });
+        contarOrdenadas(m);
+
+        // La posición k debe recibir la arista orden[k]
+        for (size_t inicio=0; inicio<m; inicio++){
+            if (orden[inicio] == inicio) continue;
+            uint32_t u0 = u[inicio], v0 = v[inicio];
+            double peso0 = peso[inicio];
+            size_t k = inicio;
+            while (orden[k] != inicio){
+                size_t siguiente = orden[k];
+                u[k] = u[siguiente];
+                v[k] = v[siguiente];
+                peso[k] = peso[siguiente];
+                orden[k] = k;
+                k = siguiente;
+            }
+            u[k] = u0;
+            v[k] = v0;
+            peso[k] = peso0;
+            orden[k] = k;
+        }
+    }
+
+    /**
+     * @brief Convierte las aristas al formato de `Edge`.
+     *
+     * @param V Nodos a los que apuntarán las aristas; `V[i].id` debe ser `i`.
+     * @return Vector de aristas en el mismo orden.
+     */
+    std::vector<Edge> aEdges(std::vector<Node>& V) const {
+        std::vector<Edge> edges;
+        edges.reserve(size());
+        for (size_t k=0; k<size(); k++) edges.push_back(Edge(&V[u[k]], &V[v[k]]));
+        return edges;
+    }
+};
+
+
+/**
+ * @brief Implementación del algoritmo de Kruskal con optimización en la operación find sobre aristas compactas.
+ *
+ * Es la misma versión que `kruskal_array_Opti`, pero recorre los arreglos de `CompactEdges`.
+ * Para no duplicar la lista de aristas, se ordena `E` en su lugar.
+ *
+ * @param E Aristas del grafo, quedan ordenadas por peso.
+ * @param n Número de nodos del grafo.
+ * @return Las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+CompactEdges kruskal_array_compacto(CompactEdges& E, int n){
+    MedidorFase medidor;
+    E.ordenar();
+    medidor.terminar(&TiemposFases::orden);
+
+    CompactEdges result;
+    if (n > 1) result.reserve(n - 1);
+
+    UnionFind uf(n);
+
+    for (size_t k=0; k<E.size(); k++){
+        CONTAR(aristasExaminadas, 1);
+        int raiz_x = uf.find(E.u[k]);
+        int raiz_y = uf.find(E.v[k]);
+
+        if (raiz_x != raiz_y) {
+            uf.union_(raiz_x, raiz_y);
+            result.push_back(E.u[k], E.v[k], E.peso[k]);
+            if (result.size() == n - 1) break; // cuando se encuentran n-1 aristas se termina
+        }
+    }
+    medidor.terminar(&TiemposFases::unionFind);
+
+    return result;
+}
+
+/**
+ * @brief Implementación del algoritmo de Kruskal con optimización en la operación find y un heap sobre aristas compactas.
+ *
+ * Es la misma versión que `kruskal_heap_Opti`, pero el heap guarda solo pares (peso, índice de la arista)
+ * en vez de copias de `Edge`.
+ *
+ * @param E Aristas del grafo.
+ * @param n Número de nodos del grafo.
+ * @return Las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+CompactEdges kruskal_heap_compacto(const CompactEdges& E, int n){
+    MedidorFase medidor;
+    typedef std::pair<double, uint32_t> Clave;
+    VectorArena<Clave> claves(E.size());
+    for (size_t k=0; k<E.size(); k++) claves[k] = Clave(E.peso[k], k);
+    medidor.terminar(&TiemposFases::copia);
+    std::priority_queue<Clave, VectorArena<Clave>, std::greater<Clave>> heap(std::greater<Clave>(), std::move(claves));
+    medidor.terminar(&TiemposFases::orden);
+
+    CompactEdges result;
+    if (n > 1) result.reserve(n - 1);
+
+    UnionFind uf(n);
+
+    while(result.size() + 1 < n){
+        uint32_t k = heap.top().second;
+        heap.pop();
+        CONTAR(aristasExaminadas, 1);
+
+        int raiz_x = uf.find(E.u[k]);
+        int raiz_y = uf.find(E.v[k]);
+
+        if (raiz_x != raiz_y) {
+            uf.union_(raiz_x, raiz_y);
+            result.push_back(E.u[k], E.v[k], E.peso[k]);
+        }
+    }
+    medidor.terminar(&TiemposFases::unionFind);
+
+    return result;
+}
@@ -0,0 +1,258 @@
+#pragma once
+#include <algorithm>    // std::sort, std::upper_bound
+#include <limits>
+#include <vector>
+#include "UnionFind.cpp"
+#include "graph.cpp"
+
+/**
+ * @brief Una unión del dendrograma: los nodos que junta, la altura a la que lo hace y cuántos puntos quedan juntos.
+ *
+ * Los nodos 0, ..., N-1 son los puntos y la unión t crea el nodo N+t, como en la matriz de enlace de scipy.
+ */
+struct UnionDendrograma {
+    int a, b;       // nodos que se unen
+    double altura;  // peso de la arista del MST que los une
+    int tamano;     // puntos del nodo creado
+};
+
+/**
+ * @class Dendrograma
+ * @brief Dendrograma de clustering de enlace simple (single-linkage) construido a partir de un MST.
+ *
+ * Los clusters de enlace simple a una altura h son las componentes del MST sin sus aristas de peso
+ * mayor que h, así que el dendrograma se obtiene recorriendo las aristas del MST por peso con un
+ * Union-Find, una sola vez, en O(N log N) si hay que ordenarlas y O(N α(N)) si ya vienen ordenadas
+ * (como las de `kruskal_array_Opti`).
+ *
+ * Además se guardan los puntos en el orden de las hojas del dendrograma: todo cluster, a cualquier
+ * altura, es un rango contiguo de ese orden. Entre cada par de puntos consecutivos se guarda la unión
+ * que los junta por primera vez, y un cluster termina donde esa unión todavía no ocurre. Con eso:
+ * - `etiquetas(k)` y `cortarEnAltura(h)` entregan los clusters en O(N), con una sola pasada.
+ * - `clustersEnAltura`, `alturaUnion`, `mismoCluster` y `rangoCluster` responden en O(log N),
+ *   con búsqueda binaria sobre las alturas o un árbol de segmentos de máximos.
+ * Ninguna consulta modifica la estructura ni vuelve a usar el Union-Find.
+ *
+ * Los pesos son distancias al cuadrado: para cortar a distancia r se usa la altura r*r.
+ *
+ * ### Ejemplo de uso:
+ * @code
+ * Graph G(generarPuntos(1000, 1));
+ * Dendrograma dendrograma(kruskal_array_Opti(G), G.V.size());
+ * std::vector<int> cinco = dendrograma.etiquetas(5);
+ * std::vector<int> cercanos = dendrograma.cortarEnAltura(0.01 * 0.01);
+ * @endcode
+ */
+class Dendrograma {
+    static constexpr int NINGUNA = std::numeric_limits<int>::max(); // entre puntos de árboles distintos del bosque
+
+    int n = 0;
+    std::vector<UnionDendrograma> unionesDendrograma;  // en orden de altura
+    std::vector<int> orden;      // puntos en el orden de las hojas
+    std::vector<int> posicion;   // posición de cada punto en `orden`
+    std::vector<int> unionEntre; // unionEntre[p]: unión que junta a orden[p] con orden[p+1]
+    std::vector<int> maximos;    // árbol de segmentos de máximos sobre `unionEntre`, la raíz es la 1
+    int hojasArbol = 1;          // potencia de 2 mayor o igual que N; las hojas sobrantes valen -1
+
+    /**
+     * @brief Uniones que se aplican para quedar con k clusters, con k ajustado a [1, N].
+     */
+    int aplicadas(int k) const {
+        return n - std::min(std::max(k, 1), n);
+    }
+
+    /**
+     * @brief Máximo de `unionEntre[desde, hasta)`, o -1 si el rango es vacío.
+     */
+    int maximoRango(int desde, int hasta) const {
+        int resultado = -1;
+        for (desde += hojasArbol, hasta += hojasArbol; desde < hasta; desde /= 2, hasta /= 2){
+            if (desde & 1) resultado = std::max(resultado, maximos[desde++]);
+            if (hasta & 1) resultado = std::max(resultado, maximos[--hasta]);
+        }
+        return resultado;
+    }
+
+    /**
+     * @brief Última posición q < p con `unionEntre[q] >= m`, o -1 si no hay.
+     */
+    int ultimoMayorIgual(int p, int m) const {
+        // Se sube desde la hoja p hasta encontrar un hermano izquierdo con un máximo suficiente
+        int v = p + hojasArbol;
+        while (v > 1){
+            if ((v & 1) && maximos[v - 1] >= m){
+                v--;
+                while (v < hojasArbol) v = maximos[2 * v + 1] >= m ? 2 * v + 1 : 2 * v;
+                return v - hojasArbol;
+            }
+            v /= 2;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Primera posición q >= p con `unionEntre[q] >= m`, o N-1 si no hay.
+     */
+    int primeroMayorIgual(int p, int m) const {
+        int v = p + hojasArbol;
+        if (maximos[v] >= m) return p;
+        while (v > 1){
+            if (!(v & 1) && maximos[v + 1] >= m){
+                v++;
+                while (v < hojasArbol) v = maximos[2 * v] >= m ? 2 * v : 2 * v + 1;
+                return v - hojasArbol;
+            }
+            v /= 2;
+        }
+        return n - 1;
+    }
+
+public:
+    /**
+     * @brief Construye el dendrograma de un MST (o de un bosque cobertor mínimo).
+     *
+     * @tparam D Número de coordenadas de los nodos; se deduce de las aristas.
+     * @param mst Aristas del MST; los ids de sus nodos deben estar en [0, n). Si no vienen ordenadas por peso se ordena una copia.
+     * @param N Número de puntos.
+     */
+    template <int D>
+    Dendrograma(const std::vector<EdgeD<D>>& mst, int N) : n(N) {
+        std::vector<UnionDendrograma> aristas;
+        aristas.reserve(mst.size());
+        for (const EdgeD<D>& e : mst) aristas.push_back({e.n1->id, e.n2->id, e.peso, 0});
+        auto menorAltura = [](const UnionDendrograma& x, const UnionDendrograma& y){ return x.altura < y.altura; };
+        if (!std::is_sorted(aristas.begin(), aristas.end(), menorAltura)) std::sort(aristas.begin(), aristas.end(), menorAltura);
+
+        // 1. Uniones, con un Union-Find sobre los puntos y el nodo del dendrograma de cada conjunto
+        UnionFind uf(n);
+        std::vector<int> nodoDe(n), tamano(n, 1);
+        for (int i=0; i<n; i++) nodoDe[i] = i;
+        for (const UnionDendrograma& e : aristas){
+            int raiz_x = uf.find(e.a);
+            int raiz_y = uf.find(e.b);
+            if (raiz_x == raiz_y) continue; // no es un bosque; la arista no cambia los clusters
+            int a = nodoDe[raiz_x], b = nodoDe[raiz_y];
+            int t = n + unionesDendrograma.size();
+            tamano.push_back(tamano[a] + tamano[b]);
+            unionesDendrograma.push_back({a, b, e.altura, tamano.back()});
+            uf.union_(raiz_x, raiz_y);
+            nodoDe[uf.find(raiz_x)] = t;
+        }
+
+        // 2. Posición de cada nodo en el orden de las hojas: los hijos de una unión siempre tienen menor
+        //    índice que ella, así que basta recorrer las uniones de la última a la primera
+        int nodos = n + unionesDendrograma.size();
+        std::vector<int> inicio(nodos, -1);
+        int siguiente = 0;
+        for (int v=nodos-1; v>=0; v--){
+            if (inicio[v] == -1){ // raíz de un árbol del bosque
+                inicio[v] = siguiente;
+                siguiente += tamano[v];
+            }
+            if (v >= n){
+                const UnionDendrograma& u = unionesDendrograma[v - n];
+                inicio[u.a] = inicio[v];
+                inicio[u.b] = inicio[v] + tamano[u.a];
+            }
+        }
+        orden.resize(n);
+        posicion.resize(n);
+        for (int i=0; i<n; i++){
+            orden[inicio[i]] = i;
+            posicion[i] = inicio[i];
+        }
+
+        // 3. La unión t junta el último punto de su hijo `a` con el primero de `b`
+        unionEntre.assign(std::max(n - 1, 0), NINGUNA);
+        for (size_t t=0; t<unionesDendrograma.size(); t++){
+            const UnionDendrograma& u = unionesDendrograma[t];
+            unionEntre[inicio[u.b] - 1] = t;
+        }
+        while (hojasArbol < n) hojasArbol *= 2;
+        maximos.assign(2 * hojasArbol, -1);
+        for (size_t p=0; p<unionEntre.size(); p++) maximos[hojasArbol + p] = unionEntre[p];
+        for (int v=hojasArbol-1; v>=1; v--) maximos[v] = std::max(maximos[2 * v], maximos[2 * v + 1]);
+    }
+
+    /**
+     * @brief Número de puntos.
+     */
+    int numPuntos() const { return n; }
+
+    /**
+     * @brief Uniones del dendrograma, en orden de altura (la unión t crea el nodo N+t).
+     */
+    const std::vector<UnionDendrograma>& uniones() const { return unionesDendrograma; }
+
+    /**
+     * @brief Puntos en el orden de las hojas; todo cluster es un rango contiguo de este orden.
+     */
+    const std::vector<int>& ordenHojas() const { return orden; }
+
+    /**
+     * @brief Número de clusters al cortar a la altura h (se unen los puntos a distancia al cuadrado h o menos). O(log N).
+     */
+    int clustersEnAltura(double h) const {
+        auto fin = std::upper_bound(unionesDendrograma.begin(), unionesDendrograma.end(), h,
+            [](double h, const UnionDendrograma& u){ return h < u.altura; });
+        return n - (fin - unionesDendrograma.begin());
+    }
+
+    /**
+     * @brief Divide los puntos en k clusters. O(N).
+     *
+     * @param k Número de clusters; se ajusta a [1, N]. Si el MST es un bosque se obtienen al menos tantos clusters como árboles.
+     * @return Cluster de cada punto, indexado por id. Los clusters se numeran desde 0 en el orden de las hojas.
+     */
+    std::vector<int> etiquetas(int k) const {
+        int m = aplicadas(k);
+        std::vector<int> cluster(n);
+        int actual = 0;
+        for (int p=0; p<n; p++){
+            if (p > 0 && unionEntre[p - 1] >= m) actual++;
+            cluster[orden[p]] = actual;
+        }
+        return cluster;
+    }
+
+    /**
+     * @brief Clusters que se obtienen al cortar el dendrograma a la altura h. O(N).
+     *
+     * @param h Altura del corte, en las unidades de los pesos (distancias al cuadrado).
+     * @return Cluster de cada punto, indexado por id, igual que `etiquetas`.
+     */
+    std::vector<int> cortarEnAltura(double h) const {
+        return etiquetas(clustersEnAltura(h));
+    }
+
+    /**
+     * @brief Altura a la que quedan juntos los puntos i y j: el peso de la arista más pesada del camino entre ellos en el MST. O(log N).
+     *
+     * @return 0 si i == j, infinito si están en árboles distintos del bosque.
+     */
+    double alturaUnion(int i, int j) const {
+        if (i == j) return 0;
+        int p = std::min(posicion[i], posicion[j]), q = std::max(posicion[i], posicion[j]);
+        int t = maximoRango(p, q);
+        return t == NINGUNA ? std::numeric_limits<double>::infinity() : unionesDendrograma[t].altura;
+    }
+
+    /**
+     * @brief Indica si los puntos i y j quedan en el mismo cluster al dividir en k clusters. O(log N).
+     */
+    bool mismoCluster(int i, int j, int k) const {
+        int p = std::min(posicion[i], posicion[j]), q = std::max(posicion[i], posicion[j]);
+        return maximoRango(p, q) < aplicadas(k);
+    }
+
+    /**
+     * @brief Cluster del punto i al dividir en k clusters, como rango de `ordenHojas()`. O(log N).
+     *
+     * @return Par [desde, hasta): los puntos del cluster son `ordenHojas()[desde, hasta)`.
+     */
+    std::pair<int, int> rangoCluster(int i, int k) const {
+        int m = aplicadas(k);
+        int p = posicion[i];
+        return {ultimoMayorIgual(p, m) + 1, primeroMayorIgual(p, m) + 1};
+    }
+};
@@ -0,0 +1,168 @@
+#pragma once
+#include <limits>
+#include <utility>      // std::swap
+#include <vector>
+
+/**
+ * @class ArbolEnlaceCorte
+ * @brief Bosque dinámico (link-cut tree de Sleator y Tarjan) con máximo de caminos.
+ *
+ * Cada nodo tiene un valor y el bosque permite, en O(log N) amortizado por operación, unir dos árboles con
+ * una arista (`enlazar`), separarlos (`cortar`) y obtener el nodo de mayor valor en el camino entre dos
+ * nodos (`maximoCamino`). Cada árbol se representa como caminos preferidos guardados en árboles splay,
+ * ordenados por profundidad; invertir un árbol splay (con una marca perezosa) cambia la raíz del árbol.
+ *
+ * Para mantener el máximo de los pesos de las aristas de un árbol, cada arista se representa como un nodo
+ * con el peso como valor, enlazado a sus dos extremos, y los nodos de los puntos tienen valor -infinito.
+ *
+ * Los nodos se piden con `agregarNodo` y sus posiciones se reutilizan después de `liberarNodo`.
+ */
+class ArbolEnlaceCorte {
+    struct Nodo {
+        int hijo[2];           // hijos en el árbol splay, -1 si no hay
+        int padre;             // padre en el árbol splay o, en la raíz del splay, padre del camino
+        bool invertido;        // los hijos del subárbol splay están pendientes de intercambiar
+        double valor;
+        int maximo;            // nodo de mayor valor del subárbol splay
+    };
+
+    std::vector<Nodo> nodos;
+    std::vector<int> libres;   // posiciones de nodos liberados
+    std::vector<int> pila;     // espacio de trabajo de `splay`
+
+    bool esRaizSplay(int x) const {
+        int p = nodos[x].padre;
+        return p == -1 || (nodos[p].hijo[0] != x && nodos[p].hijo[1] != x);
+    }
+
+    void actualizar(int x){
+        Nodo& n = nodos[x];
+        n.maximo = x;
+        for (int h : n.hijo){
+            if (h != -1 && nodos[nodos[h].maximo].valor > nodos[n.maximo].valor) n.maximo = nodos[h].maximo;
+        }
+    }
+
+    void empujar(int x){
+        Nodo& n = nodos[x];
+        if (!n.invertido) return;
+        std::swap(n.hijo[0], n.hijo[1]);
+        for (int h : n.hijo) if (h != -1) nodos[h].invertido = !nodos[h].invertido;
+        n.invertido = false;
+    }
+
+    void rotar(int x){
+        int p = nodos[x].padre, g = nodos[p].padre;
+        int lado = nodos[p].hijo[1] == x;
+        int b = nodos[x].hijo[!lado];
+        if (!esRaizSplay(p)) nodos[g].hijo[nodos[g].hijo[1] == p] = x;
+        nodos[x].padre = g;
+        nodos[x].hijo[!lado] = p;
+        nodos[p].padre = x;
+        nodos[p].hijo[lado] = b;
+        if (b != -1) nodos[b].padre = p;
+        actualizar(p);
+        actualizar(x);
+    }
+
+    /**
+     * @brief Lleva `x` a la raíz de su árbol splay, después de aplicar las inversiones pendientes sobre él.
+     */
+    void splay(int x){
+        pila.clear();
+        for (int y=x; ; y=nodos[y].padre){
+            pila.push_back(y);
+            if (esRaizSplay(y)) break;
+        }
+        for (size_t k=pila.size(); k>0; k--) empujar(pila[k-1]);
+
+        while (!esRaizSplay(x)){
+            int p = nodos[x].padre;
+            if (!esRaizSplay(p)){
+                int g = nodos[p].padre;
+                if ((nodos[g].hijo[0] == p) == (nodos[p].hijo[0] == x)) rotar(p); else rotar(x);
+            }
+            rotar(x);
+        }
+    }
+
+    /**
+     * @brief Deja el camino desde la raíz del árbol hasta `x` como un solo árbol splay con `x` en su raíz.
+     */
+    void acceder(int x){
+        for (int y=-1, z=x; z!=-1; y=z, z=nodos[z].padre){
+            splay(z);
+            nodos[z].hijo[1] = y;
+            actualizar(z);
+        }
+        splay(x);
+    }
+
+    /**
+     * @brief Hace que `x` sea la raíz de su árbol.
+     */
+    void hacerRaiz(int x){
+        acceder(x);
+        nodos[x].invertido = !nodos[x].invertido;
+    }
+
+public:
+    /**
+     * @brief Agrega un nodo aislado con el valor dado.
+     *
+     * @return Posición del nodo.
+     */
+    int agregarNodo(double valor){
+        int x;
+        if (libres.empty()){
+            x = nodos.size();
+            nodos.emplace_back();
+        } else {
+            x = libres.back();
+            libres.pop_back();
+        }
+        nodos[x] = {{-1, -1}, -1, false, valor, x};
+        return x;
+    }
+
+    /**
+     * @brief Libera un nodo, que debe estar aislado, para reutilizar su posición.
+     */
+    void liberarNodo(int x){
+        libres.push_back(x);
+    }
+
+    /**
+     * @brief Une los árboles de `x` e `y`, que deben ser distintos, con una arista entre ellos.
+     */
+    void enlazar(int x, int y){
+        hacerRaiz(x);
+        nodos[x].padre = y;
+    }
+
+    /**
+     * @brief Quita la arista entre `x` e `y`, que deben ser vecinos.
+     */
+    void cortar(int x, int y){
+        hacerRaiz(x);
+        acceder(y);
+        // El camino es solo x-y, así que x es el hijo izquierdo de y
+        nodos[y].hijo[0] = -1;
+        nodos[x].padre = -1;
+        actualizar(y);
+    }
+
+    /**
+     * @brief Nodo de mayor valor en el camino entre `x` e `y`, que deben estar en el mismo árbol.
+     */
+    int maximoCamino(int x, int y){
+        hacerRaiz(x);
+        acceder(y);
+        return nodos[y].maximo;
+    }
+
+    /**
+     * @brief Valor del nodo `x`.
+     */
+    double valor(int x) const { return nodos[x].valor; }
+};
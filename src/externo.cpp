@@ -0,0 +1,248 @@
+#pragma once
+#include <algorithm>    // std::sort
+#include <cstdio>
+#include <cstdlib>      // mkstemp
+#include <functional>   // std::greater
+#include <queue>
+#include <string>
+#include <unistd.h>
+#include "UnionFind.cpp"
+#include "archivoBinario.cpp"
+
+// Kruskal en memoria externa: el arreglo de aristas de un archivo binario (ver `archivoBinario.cpp`)
+// se procesa con una cantidad acotada de memoria, de modo que sirve para grafos cuyas aristas no caben en RAM.
+
+/**
+ * @brief Ordena un bloque de aristas por peso.
+ */
+void ordenarBloque(AristaBinaria* inicio, AristaBinaria* fin){
+    std::sort(inicio, fin, [](const AristaBinaria& a, const AristaBinaria& b){ return a.peso < b.peso; });
+}
+
+/**
+ * @class CorridaExterna
+ * @brief Archivo temporal con una secuencia de aristas ordenadas por peso.
+ *
+ * El archivo se borra del directorio apenas se crea, así que desaparece al cerrarlo aunque
+ * el programa termine con un error. Se lee de a bloques con un buffer de tamaño fijo.
+ */
+class CorridaExterna {
+    FILE* archivo = nullptr;
+    std::vector<AristaBinaria> buffer;
+    size_t posicion = 0;
+    size_t cantidad = 0;
+
+public:
+    CorridaExterna(const CorridaExterna&) = delete;
+    CorridaExterna& operator=(const CorridaExterna&) = delete;
+
+    /**
+     * @brief Crea un archivo temporal vacío en `directorio`.
+     */
+    CorridaExterna(const std::string& directorio){
+        std::string plantilla = directorio + "/kruskal_externo_XXXXXX";
+        int fd = mkstemp(&plantilla[0]);
+        if (fd == -1) return;
+        unlink(plantilla.c_str());
+        archivo = fdopen(fd, "w+b");
+    }
+
+    ~CorridaExterna(){ if (archivo) fclose(archivo); }
+
+    bool valida() const { return archivo != nullptr; }
+
+    /**
+     * @brief Agrega aristas al final del archivo.
+     */
+    bool escribir(const AristaBinaria* aristas, size_t m){
+        return fwrite(aristas, sizeof(AristaBinaria), m, archivo) == m;
+    }
+
+    /**
+     * @brief Vuelve al inicio del archivo para leerlo, con un buffer de `capacidad` aristas.
+     */
+    void empezarLectura(size_t capacidad){
+        fflush(archivo);
+        rewind(archivo);
+        buffer.assign(std::max<size_t>(capacidad, 1), AristaBinaria());
+        posicion = cantidad = 0;
+    }
+
+    /**
+     * @brief Entrega la siguiente arista del archivo.
+     *
+     * @param arista Donde se guarda la arista leída.
+     * @return false si no quedan aristas.
+     */
+    bool siguiente(AristaBinaria& arista){
+        if (posicion == cantidad){
+            cantidad = fread(buffer.data(), sizeof(AristaBinaria), buffer.size(), archivo);
+            posicion = 0;
+            if (cantidad == 0) return false;
+        }
+        arista = buffer[posicion++];
+        return true;
+    }
+};
+
+/**
+ * @brief Mezcla corridas ordenadas y entrega las aristas en orden de peso a `f`.
+ *
+ * Usa un heap con la siguiente arista de cada corrida. La mezcla se detiene cuando `f` retorna false.
+ *
+ * @param corridas Corridas por mezclar.
+ * @param capacidad Tamaño en aristas del buffer de lectura de cada corrida.
+ * @param f Función que recibe cada arista y retorna si se debe seguir.
+ */
+template <class F>
+void mezclarCorridas(std::vector<CorridaExterna*>& corridas, size_t capacidad, F f){
+    typedef std::pair<double, size_t> Entrada; // (peso, corrida)
+    std::priority_queue<Entrada, std::vector<Entrada>, std::greater<Entrada>> heap;
+    std::vector<AristaBinaria> actual(corridas.size());
+
+    for (size_t c=0; c<corridas.size(); c++){
+        corridas[c]->empezarLectura(capacidad);
+        if (corridas[c]->siguiente(actual[c])) heap.push(Entrada(actual[c].peso, c));
+    }
+    while (!heap.empty()){
+        size_t c = heap.top().second;
+        heap.pop();
+        if (!f(actual[c])) return;
+        if (corridas[c]->siguiente(actual[c])) heap.push(Entrada(actual[c].peso, c));
+    }
+}
+
+/**
+ * @brief Kruskal en memoria externa sobre las aristas de un archivo binario.
+ *
+ * 1. Se leen las aristas de a bloques de `memoria` bytes; cada bloque se ordena y se escribe
+ *    como una corrida en un archivo temporal.
+ * 2. Si hay más corridas de las que se pueden mezclar con buffers razonables, se mezclan por grupos
+ *    en corridas más largas hasta que quedan pocas.
+ * 3. Las corridas restantes se mezclan y el flujo ordenado se entrega al Union-Find, deteniéndose
+ *    al encontrar N-1 aristas.
+ *
+ * Si todas las aristas caben en un bloque se procesan en memoria, sin archivos temporales.
+ * El límite de memoria se aplica a las aristas; además se usan 8 bytes por nodo para el Union-Find
+ * y 16 bytes por arista del MST.
+ *
+ * El grafo puede ser cualquiera con pesos reales; no se usan las coordenadas de los puntos.
+ *
+ * @param ruta Archivo binario con aristas.
+ * @param memoria Memoria máxima, en bytes, para las aristas.
+ * @param directorio Directorio donde se crean las corridas temporales.
+ * @return Aristas del MST (del bosque cobertor mínimo si el grafo no es conexo); vacío si hay un error.
+ */
+std::vector<AristaBinaria> kruskal_externo(const std::string& ruta, size_t memoria, const std::string& directorio = "/tmp"){
+    const size_t MIN_BUFFER = 4096; // aristas mínimas por buffer de lectura durante la mezcla
+    std::vector<AristaBinaria> result;
+
+    ArchivoMST archivo;
+    if (!archivo.abrir(ruta)) return result;
+    size_t n = archivo.numPuntos();
+    size_t m = archivo.numAristas();
+    uint64_t inicioAristas = archivo.inicioAristas();
+    archivo.cerrar(); // las aristas se leen con read, para no dejar el archivo completo mapeado
+
+    size_t capacidad = std::max<size_t>(memoria / sizeof(AristaBinaria), 3 * MIN_BUFFER);
+    std::vector<AristaBinaria> bloque(std::min(capacidad, m));
+
+    UnionFind uf(n);
+    bool error = false;
+    auto procesar = [&](const AristaBinaria& a){
+        if (a.u >= n || a.v >= n){
+            std::cerr << "Hay una arista que une nodos que no existen\n";
+            error = true;
+            return false;
+        }
+        int raiz_x = uf.find(a.u);
+        int raiz_y = uf.find(a.v);
+
+        if (raiz_x != raiz_y) {
+            uf.union_(raiz_x, raiz_y);
+            result.push_back(a);
+            if (result.size() + 1 == n) return false; // cuando se encuentran n-1 aristas se termina
+        }
+        return true;
+    };
+
+    std::ifstream entrada(ruta, std::ios::binary);
+    entrada.seekg(inicioAristas);
+
+    // Caso en que todas las aristas caben en memoria
+    if (m <= capacidad){
+        entrada.read((char*)bloque.data(), m * sizeof(AristaBinaria));
+        if (!entrada || (size_t)entrada.gcount() != m * sizeof(AristaBinaria)){
+            std::cerr << "No se pudieron leer las aristas de '" << ruta << "'\n";
+            return {};
+        }
+        ordenarBloque(bloque.data(), bloque.data() + m);
+        for (size_t k=0; k<m && procesar(bloque[k]); k++);
+        return error ? std::vector<AristaBinaria>() : result;
+    }
+
+    // 1. Formación de corridas
+    std::vector<CorridaExterna*> corridas;
+    auto liberar = [&corridas](){
+        for (CorridaExterna* c : corridas) delete c;
+        corridas.clear();
+    };
+    for (size_t leidas=0; leidas<m; ){
+        size_t cantidad = std::min(capacidad, m - leidas);
+        // Se verifica la lectura antes de ordenar, para no procesar un bloque incompleto
+        entrada.read((char*)bloque.data(), cantidad * sizeof(AristaBinaria));
+        if (!entrada || (size_t)entrada.gcount() != cantidad * sizeof(AristaBinaria)){
+            std::cerr << "No se pudieron leer las aristas de '" << ruta << "'\n";
+            liberar();
+            return {};
+        }
+        ordenarBloque(bloque.data(), bloque.data() + cantidad);
+        CorridaExterna* corrida = new CorridaExterna(directorio);
+        corridas.push_back(corrida);
+        if (!corrida->valida() || !corrida->escribir(bloque.data(), cantidad)){
+            std::cerr << "Error al escribir en '" << directorio << "'\n";
+            liberar();
+            return {};
+        }
+        leidas += cantidad;
+    }
+    bloque = std::vector<AristaBinaria>(); // se libera antes de mezclar
+
+    // 2. Mezclas intermedias, hasta que cada corrida tenga un buffer de al menos MIN_BUFFER aristas
+    size_t maxCorridas = capacidad / MIN_BUFFER - 1; // se reserva un buffer para la salida; es al menos 2
+    while (corridas.size() > maxCorridas){
+        std::vector<CorridaExterna*> nuevas;
+        for (size_t inicio=0; inicio<corridas.size(); inicio+=maxCorridas){
+            std::vector<CorridaExterna*> grupo(corridas.begin() + inicio,
+                                               corridas.begin() + std::min(inicio + maxCorridas, corridas.size()));
+            CorridaExterna* mezcla = new CorridaExterna(directorio);
+            nuevas.push_back(mezcla);
+            std::vector<AristaBinaria> salida;
+            salida.reserve(MIN_BUFFER);
+            bool ok = mezcla->valida();
+            mezclarCorridas(grupo, capacidad / (grupo.size() + 1), [&](const AristaBinaria& a){
+                salida.push_back(a);
+                if (salida.size() == MIN_BUFFER){
+                    ok = ok && mezcla->escribir(salida.data(), salida.size());
+                    salida.clear();
+                }
+                return ok;
+            });
+            ok = ok && mezcla->escribir(salida.data(), salida.size());
+            for (CorridaExterna* c : grupo) delete c;
+            if (!ok){
+                std::cerr << "Error al escribir en '" << directorio << "'\n";
+                for (size_t k=inicio+grupo.size(); k<corridas.size(); k++) delete corridas[k];
+                corridas = nuevas;
+                liberar();
+                return {};
+            }
+        }
+        corridas = nuevas;
+    }
+
+    // 3. Mezcla final y Kruskal
+    mezclarCorridas(corridas, capacidad / corridas.size(), procesar);
+    liberar();
+    return error ? std::vector<AristaBinaria>() : result;
+}
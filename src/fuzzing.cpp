@@ -0,0 +1,257 @@
+#pragma once
+#include <algorithm>    // std::min, std::max
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdio>       // std::remove
+#include <unistd.h>     // mkstemp, close
+#include "benchmark.cpp"
+#include "archivoBinario.cpp"
+#include "externo.cpp"
+#include "incremental.cpp"
+#include "verificacion.cpp"
+
+/**
+ * @brief Tipos de entrada que genera el fuzzing diferencial.
+ *
+ * Además de las distribuciones de `generarPuntos` hay entradas adversariales, con muchos pesos
+ * repetidos, que es donde las variantes pueden diferir en cómo rompen los empates.
+ */
+enum CasoFuzzing {
+    CASO_UNIFORME,     // `PUNTOS_UNIFORMES`
+    CASO_CLUSTERS,     // `PUNTOS_CLUSTERS`
+    CASO_GRILLA,       // `PUNTOS_GRILLA`
+    CASO_DUPLICADOS,   // pocos puntos distintos repetidos muchas veces: aristas de peso 0
+    CASO_COLINEALES,   // puntos sobre una recta, a distancias enteras de un origen
+    CASO_ENTEROS,      // coordenadas enteras en [0, 4): muy pocos pesos distintos
+    NUM_CASOS
+};
+
+/**
+ * @brief Nombre del tipo de entrada, para los reportes.
+ */
+const char* nombreCaso(CasoFuzzing caso){
+    switch (caso){
+        case CASO_UNIFORME: return "uniforme";
+        case CASO_CLUSTERS: return "clusters";
+        case CASO_GRILLA: return "grilla";
+        case CASO_DUPLICADOS: return "duplicados";
+        case CASO_COLINEALES: return "colineales";
+        default: return "enteros";
+    }
+}
+
+/**
+ * @brief Genera N puntos de un tipo de entrada, de forma reproducible.
+ *
+ * @param caso Tipo de entrada.
+ * @param N Número de puntos.
+ * @param semilla Semilla del generador.
+ */
+std::vector<Node> generarCaso(CasoFuzzing caso, int N, uint64_t semilla){
+    switch (caso){
+        case CASO_UNIFORME: return generarPuntos(N, semilla, PUNTOS_UNIFORMES);
+        case CASO_CLUSTERS: return generarPuntos(N, semilla, PUNTOS_CLUSTERS);
+        case CASO_GRILLA: return generarPuntos(N, semilla, PUNTOS_GRILLA);
+        default: break;
+    }
+    Xoshiro256 gen(semilla);
+    std::vector<Node> nodos;
+    if (caso == CASO_DUPLICADOS){
+        std::vector<Node> distintos = generarPuntos(1 + N / 4, semilla);
+        for (int k=0; k<N; k++) nodos.push_back(distintos[gen.siguiente() % distintos.size()]);
+    } else if (caso == CASO_COLINEALES){
+        // Sobre una recta diagonal, así ninguna coordenada basta para separar los puntos
+        for (int k=0; k<N; k++){
+            double t = gen.siguiente() % (N / 2 + 1);
+            nodos.push_back(Node(3 * t, 4 * t));
+        }
+    } else {
+        for (int k=0; k<N; k++) nodos.push_back(Node(gen.siguiente() % 4, gen.siguiente() % 4));
+    }
+    return nodos;
+}
+
+/**
+ * @brief Una discrepancia encontrada por el fuzzing diferencial.
+ */
+struct FallaVerificacion {
+    std::string variante;
+    CasoFuzzing caso;
+    int N;
+    uint64_t semilla;       // semilla de los puntos, para reproducir el caso con `generarCaso`
+    std::string motivo;
+};
+
+/**
+ * @brief Verifica `kruskal_externo` sobre las aristas de un grafo.
+ *
+ * Las aristas se escriben en un archivo temporal y se pide la memoria mínima, así que desde unos
+ * 12000 aristas el MST sale de mezclar varias corridas en disco.
+ *
+ * @param G Grafo del caso.
+ * @param temporal Directorio del archivo de entrada y de las corridas.
+ */
+CertificadoMST verificarExterno(Graph& G, const std::string& temporal){
+    CertificadoMST r;
+    std::string ruta = temporal + "/fuzzing_externo_XXXXXX";
+    int fd = mkstemp(&ruta[0]);
+    if (fd == -1 || !escribirArchivoMST(ruta, G.V, {}, G.E)){
+        if (fd != -1){
+            close(fd);
+            std::remove(ruta.c_str());
+        }
+        r.valido = false;
+        r.motivo = "no se pudo escribir el archivo de entrada en '" + temporal + "'";
+        return r;
+    }
+    close(fd);
+    std::vector<AristaBinaria> mst = kruskal_externo(ruta, 0, temporal);
+    std::remove(ruta.c_str());
+
+    // Se conserva el peso entregado, para que `verificarMST` lo compare con la distancia
+    std::vector<Edge> arbol;
+    for (const AristaBinaria& a : mst){
+        if (a.u >= G.V.size() || a.v >= G.V.size()){
+            r.valido = false;
+            r.motivo = "entregó una arista con un nodo fuera de rango";
+            return r;
+        }
+        arbol.push_back(Edge(&G.V[a.u], &G.V[a.v]));
+        arbol.back().peso = a.peso;
+    }
+    return verificarMST(G.E, G.V.size(), arbol);
+}
+
+/**
+ * @brief Aplica a `MSTIncremental` una secuencia aleatoria de inserciones y eliminaciones y verifica el árbol en cada paso.
+ *
+ * Se parte con la primera mitad de los puntos; en cada paso se inserta un lote de 1 a 4 de los puntos
+ * restantes o se elimina un punto activo al azar, hasta insertarlos todos y eliminar un cuarto de ellos.
+ * Después de cada paso el árbol se pasa a los ids de los puntos activos y se verifica con `verificarMST`
+ * sobre el grafo completo de esos puntos.
+ *
+ * @param puntos Puntos del caso.
+ * @param semilla Semilla de la secuencia.
+ */
+CertificadoMST verificarIncremental(const std::vector<Node>& puntos, uint64_t semilla){
+    const size_t ELIMINACIONES = puntos.size() / 4 + 1; // eliminaciones al azar, además de las inserciones
+    Xoshiro256 gen(semilla, 1);
+    size_t insertados = puntos.size() / 2;
+    MSTIncremental mst(std::vector<Node>(puntos.begin(), puntos.begin() + insertados));
+    std::vector<int> ids(insertados); // ids de los puntos activos
+    for (size_t k=0; k<insertados; k++) ids[k] = k;
+    size_t eliminados = 0;
+
+    for (int paso=0; insertados < puntos.size() || (eliminados < ELIMINACIONES && !ids.empty()); paso++){
+        if (insertados < puntos.size() && (ids.empty() || eliminados >= ELIMINACIONES || gen.siguiente() % 3 != 0)){
+            size_t cantidad = std::min<size_t>(1 + gen.siguiente() % 4, puntos.size() - insertados);
+            std::vector<int> nuevos = mst.insertar(std::vector<Node>(puntos.begin() + insertados, puntos.begin() + insertados + cantidad));
+            ids.insert(ids.end(), nuevos.begin(), nuevos.end());
+            insertados += cantidad;
+        } else {
+            size_t i = gen.siguiente() % ids.size();
+            mst.eliminar(ids[i]);
+            ids[i] = ids.back();
+            ids.pop_back();
+            eliminados++;
+        }
+
+        // Ids de los puntos activos en el grafo de verificación, -1 para los eliminados
+        std::vector<int> nuevoId(mst.nodos().size(), -1);
+        std::vector<Node> activos;
+        for (size_t id=0; id<mst.nodos().size(); id++){
+            if (!mst.estaActivo(id)) continue;
+            nuevoId[id] = activos.size();
+            activos.push_back(mst.nodos()[id]);
+        }
+        Graph GA(activos, 1);
+        std::vector<Edge> arbol;
+        CertificadoMST r;
+        for (const Edge& e : mst.aristas()){
+            if (nuevoId[e.n1->id] == -1 || nuevoId[e.n2->id] == -1){
+                r.valido = false;
+                r.motivo = "paso " + std::to_string(paso) + ": la arista (" + std::to_string(e.n1->id) + ", "
+                         + std::to_string(e.n2->id) + ") usa un punto eliminado";
+                return r;
+            }
+            arbol.push_back(Edge(&GA.V[nuevoId[e.n1->id]], &GA.V[nuevoId[e.n2->id]]));
+        }
+        r = verificarMST(GA.E, activos.size(), arbol);
+        if (!r.valido){
+            r.motivo = "paso " + std::to_string(paso) + ": " + r.motivo;
+            return r;
+        }
+    }
+    return CertificadoMST();
+}
+
+/**
+ * @brief Ejecuta todas las variantes registradas sobre entradas aleatorias y adversariales y las verifica.
+ *
+ * Para cada caso se elige un tipo de entrada (en ciclo, ver `CasoFuzzing`) y un N en [1, nMax], se
+ * construyen el grafo completo y el implícito y se ejecutan todas las variantes de `variantesRegistradas`:
+ * - Las exactas deben entregar un MST según `verificarMST`.
+ * - Las de menor precisión o aproximadas deben entregar un árbol cobertor según `verificarArbolCobertor`.
+ * - Todas se comparan con la referencia, `kruskal_array`: las exactas con `pesosIguales` y las demás con
+ *   su tolerancia. Si la referencia tampoco es un MST se reporta como una falla más.
+ * - Los motores que no son variantes del benchmark se verifican aparte: `kruskal_externo` con la memoria
+ *   mínima (ver `verificarExterno`) y `MSTIncremental` con inserciones y eliminaciones al azar (ver
+ *   `verificarIncremental`).
+ *
+ * Todo depende solo de la semilla, así que una falla se reproduce con la misma semilla y el mismo caso.
+ *
+ * @param casos Número de casos.
+ * @param semilla Semilla de los casos.
+ * @param nMax Número máximo de puntos de un caso.
+ * @param hilos Hilos que usan las variantes paralelas.
+ * @param temporal Directorio para los archivos de `kruskal_externo`.
+ * @return Las fallas encontradas, a lo más una por variante y caso.
+ */
+std::vector<FallaVerificacion> fuzzingDiferencial(int casos, uint64_t semilla, int nMax, int hilos, const std::string& temporal = "/tmp"){
+    std::vector<Variante> variantes = variantesRegistradas(hilos);
+    std::vector<FallaVerificacion> fallas;
+
+    for (int k=0; k<casos; k++){
+        CasoFuzzing caso = (CasoFuzzing)(k % NUM_CASOS);
+        uint64_t semillaCaso = splitmix64(semilla * 1000003 + k);
+        // La mitad de los casos es pequeña, donde más se notan los bordes (N = 1, 2, 3, ...)
+        int N = 1 + semillaCaso % (k % 2 ? std::max(nMax, 1) : std::min(nMax, 16));
+        std::vector<Node> nodos = generarCaso(caso, N, semillaCaso);
+        Graph G(nodos, 1);
+        ImplicitGraph GI(nodos);
+
+        std::vector<Edge> referencia = kruskal_array(G);
+        double pesoReferencia = pesoTotal(referencia);
+        auto reportar = [&](const std::string& variante, const std::string& motivo){
+            fallas.push_back({variante, caso, N, semillaCaso, motivo});
+        };
+        CertificadoMST certificado = verificarMST(G.E, N, referencia);
+        if (!certificado.valido) reportar("kruskal_array", certificado.motivo);
+
+        for (const Variante& var : variantes){
+            std::vector<Edge> MST = var.implicito ? var.implicito(GI) : var.completo(G);
+            certificado = var.tolerancia == 0 ? verificarMST(G.E, N, MST) : verificarArbolCobertor(MST, N);
+            if (!certificado.valido){
+                reportar(var.nombre, certificado.motivo);
+                continue;
+            }
+            double peso = pesoTotal(MST);
+            bool iguales = var.tolerancia == 0 ? pesosIguales(peso, pesoReferencia, N)
+                                               : std::abs(peso - pesoReferencia) <= var.tolerancia * pesoReferencia;
+            if (!iguales){
+                std::ostringstream motivo;
+                motivo.precision(17);
+                motivo << "obtuvo peso " << peso << " y kruskal_array obtuvo " << pesoReferencia;
+                reportar(var.nombre, motivo.str());
+            }
+        }
+
+        certificado = verificarExterno(G, temporal);
+        if (!certificado.valido) reportar("kruskal_externo", certificado.motivo);
+        certificado = verificarIncremental(nodos, semillaCaso);
+        if (!certificado.valido) reportar("MSTIncremental", certificado.motivo);
+    }
+    return fallas;
+}
@@ -0,0 +1,193 @@
+#pragma once
+#include <algorithm>    // std::min, std::max
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include "graph.cpp"
+#include "aux_f.cpp"
+
+/**
+ * @brief Distribuciones disponibles para generar los puntos de un experimento.
+ */
+enum DistribucionPuntos {
+    PUNTOS_UNIFORMES,  // uniformes en el cuadrado [0, 1] x [0, 1]
+    PUNTOS_CLUSTERS,   // nubes gaussianas alrededor de centros uniformes (pueden salir del cuadrado)
+    PUNTOS_GRILLA      // grilla regular con una pequeña perturbación; genera muchos pesos casi repetidos
+};
+
+/**
+ * @brief Nombre de la distribución, el mismo que se acepta en la línea de comandos.
+ */
+const char* nombreDistribucion(DistribucionPuntos distribucion){
+    switch (distribucion){
+        case PUNTOS_CLUSTERS: return "clusters";
+        case PUNTOS_GRILLA: return "grilla";
+        default: return "uniforme";
+    }
+}
+
+/**
+ * @brief Busca una distribución por su nombre.
+ *
+ * @param nombre Nombre de la distribución (ver `nombreDistribucion`).
+ * @param distribucion Donde se guarda la distribución encontrada.
+ * @return true si el nombre corresponde a una distribución, false en caso contrario.
+ */
+bool distribucionPorNombre(const std::string& nombre, DistribucionPuntos& distribucion){
+    for (DistribucionPuntos d : {PUNTOS_UNIFORMES, PUNTOS_CLUSTERS, PUNTOS_GRILLA}){
+        if (nombre == nombreDistribucion(d)){
+            distribucion = d;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Mezcla un entero de 64 bits con SplitMix64; se usa para derivar semillas independientes.
+ */
+inline uint64_t splitmix64(uint64_t x){
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @class Xoshiro256
+ * @brief Generador pseudoaleatorio xoshiro256** de 64 bits.
+ *
+ * Es mucho más rápido que `std::mt19937_64` y su estado ocupa 32 bytes. Los reales uniformes
+ * se calculan aquí en vez de con `std::uniform_real_distribution`, cuyo resultado depende de la
+ * biblioteca estándar: así una semilla produce los mismos puntos uniformes y de grilla con cualquier
+ * compilador. Las normales usan `std::log` y `std::cos`, cuyo último bit puede variar entre
+ * bibliotecas matemáticas, así que los puntos en clusters solo se repiten con la misma biblioteca.
+ */
+class Xoshiro256 {
+    uint64_t s[4];
+
+    static uint64_t rotar(uint64_t x, int k){ return (x << k) | (x >> (64 - k)); }
+
+public:
+    /**
+     * @brief Crea el flujo número `flujo` de la semilla `semilla`.
+     *
+     * El estado se llena con SplitMix64, así flujos distintos de la misma semilla son independientes.
+     */
+    Xoshiro256(uint64_t semilla, uint64_t flujo = 0){
+        uint64_t x = splitmix64(semilla) ^ splitmix64(flujo + 0x632BE59BD9B4E019ULL);
+        for (int k=0; k<4; k++){
+            x = splitmix64(x);
+            s[k] = x;
+        }
+    }
+
+    uint64_t siguiente(){
+        uint64_t resultado = rotar(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotar(s[3], 45);
+        return resultado;
+    }
+
+    /**
+     * @brief Real uniforme en [0, 1), con 53 bits aleatorios.
+     */
+    double uniforme(){ return (siguiente() >> 11) * 0x1.0p-53; }
+
+    /**
+     * @brief Normal estándar, con el método de Box-Muller.
+     *
+     * Depende de `std::log` y `std::cos`, así que puede cambiar en el último bit con otra biblioteca matemática.
+     */
+    double normal(){
+        double u = 1.0 - uniforme(); // en (0, 1], para que el logaritmo sea finito
+        double v = uniforme();
+        return std::sqrt(-2.0 * std::log(u)) * std::cos(2.0 * M_PI * v);
+    }
+};
+
+/**
+ * @brief Genera N puntos con una semilla, de forma reproducible y opcionalmente en paralelo.
+ *
+ * Los puntos se generan en bloques de tamaño fijo, cada uno con su propio flujo de `Xoshiro256`
+ * derivado de la semilla y del número de bloque. Por eso el resultado es idéntico bit a bit para
+ * cualquier número de hilos.
+ *
+ * - `PUNTOS_UNIFORMES`: cada coordenada es uniforme en [0, 1).
+ * - `PUNTOS_CLUSTERS`: se eligen max(1, N/1000) centros uniformes y cada punto sigue una normal de
+ *   desviación 0.02 alrededor de un centro elegido al azar.
+ * - `PUNTOS_GRILLA`: el punto k se ubica en la celda k de una grilla de ceil(N^(1/D)) celdas por lado sobre el
+ *   cubo unitario, desplazado al azar hasta un 5% del lado de la celda.
+ *
+ * ### Ejemplo de uso:
+ * @code
+ * std::vector<Node> nodos = generarPuntos(1024, 42, PUNTOS_CLUSTERS, 4);
+ * Graph G(nodos, 4);
+ * std::vector<NodeD<8>> embeddings = generarPuntos<8>(1024, 42);
+ * @endcode
+ *
+ * @tparam D Número de coordenadas de los puntos.
+ * @param N Número de puntos.
+ * @param semilla Semilla del generador.
+ * @param distribucion Distribución de los puntos.
+ * @param hilos Número de hilos a usar.
+ * @return Vector con los N puntos, sin identificadores asignados (los asigna el grafo).
+ */
+template <int D = 2>
+std::vector<NodeD<D>> generarPuntos(int N, uint64_t semilla, DistribucionPuntos distribucion = PUNTOS_UNIFORMES, int hilos = 1){
+    typedef NodeD<D> Node;
+    const size_t BLOQUE = 4096; // puntos generados por cada flujo
+    const double ORIGEN[D] = {};
+    std::vector<Node> nodos(N > 0 ? N : 0, Node(ORIGEN));
+    if (N <= 0) return nodos;
+
+    // Los centros usan el primer flujo; los bloques de puntos, los siguientes
+    std::vector<Node> centros;
+    if (distribucion == PUNTOS_CLUSTERS){
+        Xoshiro256 gen(semilla, 0);
+        int k = std::max(1, N / 1000);
+        for (int c=0; c<k; c++){
+            double x[D];
+            for (int d=0; d<D; d++) x[d] = gen.uniforme();
+            centros.push_back(Node(x));
+        }
+    }
+    // Menor número de celdas por lado con el que caben N celdas; en 2-D es ceil(sqrt(N))
+    size_t columnas = 1;
+    while (true){
+        size_t celdas = 1;
+        for (int d=0; d<D && celdas<(size_t)N; d++) celdas *= columnas;
+        if (celdas >= (size_t)N) break;
+        columnas++;
+    }
+
+    size_t bloques = (N + BLOQUE - 1) / BLOQUE;
+    enParalelo(std::min<size_t>(std::max(hilos, 1), bloques), bloques, [&](size_t desde, size_t hasta, int){
+        for (size_t b=desde; b<hasta; b++){
+            Xoshiro256 gen(semilla, b + 1);
+            for (size_t k=b*BLOQUE; k<std::min((b + 1) * BLOQUE, (size_t)N); k++){
+                Node& p = nodos[k];
+                if (distribucion == PUNTOS_CLUSTERS){
+                    const Node& c = centros[gen.siguiente() % centros.size()];
+                    for (int d=0; d<D; d++) p[d] = c[d] + 0.02 * gen.normal();
+                } else if (distribucion == PUNTOS_GRILLA){
+                    double desplazamiento[D];
+                    for (int d=0; d<D; d++) desplazamiento[d] = 0.1 * (gen.uniforme() - 0.5);
+                    size_t celda = k; // sus dígitos en base `columnas` son la posición en cada eje
+                    for (int d=0; d<D; d++){
+                        p[d] = (celda % columnas + 0.5 + desplazamiento[d]) / columnas;
+                        celda /= columnas;
+                    }
+                } else {
+                    for (int d=0; d<D; d++) p[d] = gen.uniforme();
+                }
+            }
+        }
+    });
+    return nodos;
+}
@@ -0,0 +1,160 @@
+#pragma once
+#include <algorithm>    // std::max_element
+#include "kdtree.cpp"
+#include "UnionFind.cpp"
+#include "aux_f.cpp"
+
+/**
+ * @brief Une componentes de puntos con rondas de Borůvka geométricas hasta que queda una sola.
+ *
+ * En cada ronda busca, con un árbol k-d, la arista más liviana que sale de cada componente y une
+ * las componentes con el Union-Find. Si las componentes iniciales son subárboles de un MST, por la
+ * propiedad del corte cada arista encontrada también pertenece a ese MST. Como el número de
+ * componentes al menos se reduce a la mitad por ronda, bastan O(log k) rondas para k componentes.
+ *
+ * Los empates se rompen con un orden total (peso, id menor, id mayor), así las aristas
+ * elegidas en una misma ronda nunca forman ciclos.
+ *
+ * No se busca la arista de la componente más grande: basta con las de las demás, que también
+ * pertenecen al MST y la unen a algo en cada ronda. Cuando las componentes iniciales vienen de un
+ * MST parcial, como en `mst_aproximado`, casi todos los puntos quedan en una sola componente y así
+ * se evitan casi todas las búsquedas.
+ *
+ * @tparam D Número de coordenadas de los nodos; se deduce de `V`.
+ * @param V Nodos del grafo; `V[i].id` debe ser `i`.
+ * @param uf Union-Find con las componentes iniciales; al terminar todos los nodos están en la misma.
+ * @param componentes Número de componentes iniciales.
+ * @param candidatas Vector al que se agregan las aristas que unen las componentes.
+ */
+template <int D>
+void unirComponentesGeometrico(std::vector<NodeD<D>>& V, UnionFind& uf, int componentes, std::vector<EdgeD<D>>& candidatas){
+    int n = V.size();
+    if (componentes < 2) return;
+
+    KDTree<D> arbol(V);
+    std::vector<int> componente(n), tamano(n);
+    std::vector<double> mejorPeso(n);
+    std::vector<int> mejorA(n), mejorB(n);
+    // Vecino más cercano de cada nodo fuera de su componente. Como las componentes solo crecen,
+    // sigue siendo válido mientras ese vecino no quede en la misma componente que el nodo.
+    std::vector<double> vecinoPeso(n);
+    std::vector<int> vecinoA(n, -1), vecinoB(n, -1);
+
+    while (componentes > 1){
+        std::fill(tamano.begin(), tamano.end(), 0);
+        for (int i=0; i<n; i++) tamano[componente[i] = uf.find(i)]++;
+        arbol.actualizarComponentes(componente);
+        int mayor = std::max_element(tamano.begin(), tamano.end()) - tamano.begin();
+
+        std::fill(mejorPeso.begin(), mejorPeso.end(), std::numeric_limits<double>::infinity());
+        std::fill(mejorA.begin(), mejorA.end(), -1);
+        std::fill(mejorB.begin(), mejorB.end(), -1);
+
+        for (int i=0; i<n; i++){
+            int c = componente[i];
+            if (c == mayor) continue;
+            if (vecinoA[i] == -1 || componente[vecinoA[i]] == componente[vecinoB[i]]){
+                // La mejor arista de la componente hasta ahora acota la búsqueda. Si no se encuentra
+                // nada mejor, el vecino de i no se conoce y se vuelve a buscar en la siguiente ronda.
+                vecinoPeso[i] = mejorPeso[c];
+                vecinoA[i] = mejorA[c];
+                vecinoB[i] = mejorB[c];
+                arbol.vecinoFuera(i, componente, vecinoPeso[i], vecinoA[i], vecinoB[i]);
+                if (vecinoA[i] != i && vecinoB[i] != i) vecinoA[i] = vecinoB[i] = -1;
+            }
+            if (vecinoA[i] == -1) continue;
+            double d = vecinoPeso[i];
+            int a = vecinoA[i], b = vecinoB[i];
+            if (d < mejorPeso[c] || (d == mejorPeso[c] && (a < mejorA[c] || (a == mejorA[c] && b < mejorB[c])))){
+                mejorPeso[c] = d;
+                mejorA[c] = a;
+                mejorB[c] = b;
+            }
+        }
+
+        for (int c=0; c<n; c++){
+            if (componente[c] != c || c == mayor) continue; // solo las raíces representan componentes
+            int raiz_x = uf.find(mejorA[c]);
+            int raiz_y = uf.find(mejorB[c]);
+            if (raiz_x != raiz_y){ // dos componentes pueden elegir la misma arista
+                uf.union_(raiz_x, raiz_y);
+                candidatas.push_back(EdgeD<D>(&V[mejorA[c]], &V[mejorB[c]]));
+                componentes--;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Calcula un conjunto de aristas candidatas que contiene al MST euclidiano.
+ *
+ * Trabaja solo con los nodos, sin el grafo completo: parte de N componentes de un nodo
+ * y las une con `unirComponentesGeometrico`, en O(log N) rondas.
+ *
+ * @param V Nodos del grafo; `V[i].id` debe ser `i`.
+ * @return Vector con las aristas candidatas (a lo más N-1).
+ */
+template <int D>
+std::vector<EdgeD<D>> aristasCandidatas(std::vector<NodeD<D>>& V){
+    int n = V.size();
+    std::vector<EdgeD<D>> candidatas;
+    if (n < 2) return candidatas;
+    candidatas.reserve(n - 1);
+
+    UnionFind uf(n);
+    unirComponentesGeometrico(V, uf, n, candidatas);
+    return candidatas;
+}
+
+/**
+ * @brief Implementación del algoritmo de Kruskal sobre un conjunto de aristas candidatas geométricas.
+ *
+ * Como el peso de las aristas es el cuadrado de la distancia euclidiana, el MST se puede obtener
+ * sin considerar las N(N-1)/2 aristas del grafo completo. Se generan las aristas candidatas con
+ * `aristasCandidatas` y se les aplica el mismo Kruskal con Union-Find optimizado que `kruskal_array_Opti`.
+ * Toma O(N log N) tiempo esperado para puntos distribuidos uniformemente, y no usa `G.E`.
+ * Sirve en cualquier dimensión, aunque el árbol k-d descarta menos celdas a medida que D crece.
+ *
+ * @param V Nodos del grafo; `V[i].id` debe ser `i`.
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+template <int D>
+std::vector<EdgeD<D>> kruskal_geometrico(std::vector<NodeD<D>>& V){
+    std::vector<EdgeD<D>> sorted_edges = aristasCandidatas(V);
+    std::sort (sorted_edges.begin(), sorted_edges.end(), sortByWeight);
+    contarOrdenadas(sorted_edges.size());
+
+    int n = V.size();
+    std::vector<EdgeD<D>> result;
+
+    UnionFind uf(n);
+
+    for (auto& edge : sorted_edges){
+        int raiz_x = uf.find(edge.n1->id);
+        int raiz_y = uf.find(edge.n2->id);
+
+        if (raiz_x != raiz_y) {
+            uf.union_(raiz_x, raiz_y);
+            result.push_back(edge);
+            if (result.size() == n - 1) break; // cuando se encuentran n-1 aristas se termina
+        }
+    }
+
+    return result;
+}
+
+/**
+ * @brief Kruskal geométrico sobre un grafo completo; solo usa sus nodos (`G.V`).
+ */
+template <int D>
+std::vector<EdgeD<D>> kruskal_geometrico(GraphD<D>& G){
+    return kruskal_geometrico(G.V);
+}
+
+/**
+ * @brief Kruskal geométrico sobre un grafo implícito.
+ */
+template <int D>
+std::vector<EdgeD<D>> kruskal_geometrico(ImplicitGraphD<D>& G){
+    return kruskal_geometrico(G.V);
+}
@@ -1,7 +1,52 @@
+#pragma once
 #include <vector>
 #include <random>
 #include <iostream>
-#include <cmath> // contiene pow
+#include <thread>
+#include <utility> // std::index_sequence
+
+
+/**
+ * @class NodeD
+ * @brief Representa un nodo de D coordenadas
+ *
+ * La clase NodeD representa un nodo como una tupla de D reales de 64 bits, guardada en el mismo nodo
+ * (sin memoria dinámica). La dimensión se fija en tiempo de compilación, así que el cálculo de
+ * distancias no tiene ciclos en tiempo de ejecución. Para D = 2 se usa la especialización `Node`.
+ * Se puede crear el nodo con valores definidos o asignarlos aleatoriamente en el rango [0, 1].
+ *
+ * @tparam D Número de coordenadas.
+ */
+template <int D>
+class NodeD {
+public:
+    int id; // Lo asigna el grafo, se usa en UnionFind
+    double coordenadas[D];
+
+    /**
+     * @brief Constructor con valores definidos.
+     *
+     * @param valores Arreglo con las D coordenadas del nodo.
+     */
+    explicit NodeD(const double* valores) {
+        for (int k=0; k<D; k++) coordenadas[k] = valores[k];
+    }
+
+    /**
+     * @brief Constructor por defecto.
+     *
+     * Crea un nodo con coordenadas aleatorias en el rango [0, 1].
+     * El generador se inicializa una sola vez por hilo; para puntos reproducibles usar `generarPuntos`.
+     */
+    NodeD() {
+        thread_local std::mt19937_64 gen(std::random_device{}());
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+        for (int k=0; k<D; k++) coordenadas[k] = dist(gen);
+    }
+
+    double& operator[](int k) { return coordenadas[k]; }
+    double operator[](int k) const { return coordenadas[k]; }
+};
 
 
 /**
@@ -10,8 +55,10 @@
  *
  * La clase Node representa un nodo como un par ordenado de reales de 64 bits (x, y).
  * Se puede crear el nodo con valores definidos o asignarlos aleatoriamente en el rango [0, 1].
+ * El operador [] permite usarlo en el código escrito para cualquier dimensión (`operator[](0)` es `x`).
  */
-class Node {
+template <>
+class NodeD<2> {
 public:
     int id; // Lo asigna el grafo, se usa en UnionFind
     double x;
@@ -25,59 +72,111 @@ public:
      * @param x_val Valor de la coordenada X.
      * @param y_val Valor de la coordenada Y.
      */
-    Node(double x_val, double y_val) : x(x_val), y(y_val) {} 
+    NodeD(double x_val, double y_val) : x(x_val), y(y_val) {} 
+
+    /**
+     * @brief Constructor con valores definidos en un arreglo {x, y}.
+     */
+    explicit NodeD(const double* valores) : x(valores[0]), y(valores[1]) {}
 
     /**
      * @brief Constructor por defecto.
      * 
      * Crea un nodo con coordenadas aleatorias en el rango [0, 1].
+     * El generador se inicializa una sola vez por hilo; para puntos reproducibles usar `generarPuntos`.
      */
-    Node() {
-        std::random_device rd;
-        std::mt19937_64 gen(rd());
+    NodeD() {
+        thread_local std::mt19937_64 gen(std::random_device{}());
         std::uniform_real_distribution<double> dist(0.0, 1.0);
 
         x = dist(gen);
         y = dist(gen);
     }
+
+    double& operator[](int k) { return k == 0 ? x : y; }
+    double operator[](int k) const { return k == 0 ? x : y; }
 };
 
+typedef NodeD<2> Node;
+
+
+/**
+ * @brief Suma de los cuadrados de las diferencias en las coordenadas K..., desenrollada en tiempo de compilación.
+ */
+template <int D, size_t... K>
+inline double sumaCuadrados(const NodeD<D>* nodo1, const NodeD<D>* nodo2, std::index_sequence<K...>){
+    return (... + (((*nodo1)[K] - (*nodo2)[K]) * ((*nodo1)[K] - (*nodo2)[K])));
+}
 
 /**
- * @class Edge
- * @brief Representa una arista con peso entre dos nodos.
+ * @brief Calcula el cuadrado de la distancia euclidiana entre dos nodos.
+ *
+ * Es el peso que se le asigna a una arista. Se usa tanto al crear aristas como en
+ * los grafos implícitos, de modo que ambos calculen exactamente el mismo valor.
+ * Las coordenadas se suman en orden, así que en 2-D es (x1 - x2)^2 + (y1 - y2)^2.
  *
- * La clase Edge modela una arista entre dos nodos
+ * @param nodo1 Puntero al primer nodo.
+ * @param nodo2 Puntero al segundo nodo.
+ * @return Cuadrado de la distancia euclidiana entre los nodos.
+ */
+template <int D>
+inline double distanciaCuadrada(const NodeD<D>* nodo1, const NodeD<D>* nodo2){
+    return sumaCuadrados(nodo1, nodo2, std::make_index_sequence<D>());
+}
+
+
+/**
+ * @class EdgeD
+ * @brief Representa una arista con peso entre dos nodos de D coordenadas.
+ *
+ * La clase EdgeD modela una arista entre dos nodos
  * El peso de la arista es el cuadrado de la distancia euclidiana entre los dos nodos.
+ * Para D = 2 se usa el nombre `Edge`.
  */
-class Edge {
+template <int D>
+class EdgeD {
 public:
-    const Node* n1; // puntero al nodo
-    const Node* n2; // puntero al nodo
+    const NodeD<D>* n1; // puntero al nodo
+    const NodeD<D>* n2; // puntero al nodo
     double peso;   // cuadrado de la distancia euclidiana
 
     /**
-     * @brief Constructor de la clase Edge.
+     * @brief Constructor de la clase EdgeD.
      *
      * Crea una arista entre dos nodos y calcula automáticamente su peso.
      *
      * @param nodo1 Puntero al primer nodo.
      * @param nodo2 Puntero al segundo nodo.
      */
-    Edge(Node* nodo1, Node* nodo2) : n1(nodo1), n2(nodo2){ 
-        peso = std::pow((nodo1->x - nodo2->x), 2) + std::pow((nodo1->y - nodo2->y), 2);
+    EdgeD(NodeD<D>* nodo1, NodeD<D>* nodo2) : n1(nodo1), n2(nodo2){
+        peso = distanciaCuadrada(nodo1, nodo2);
     }
+
+    /**
+     * @brief Constructor por defecto.
+     *
+     * No inicializa la arista; permite dimensionar un arreglo de aristas que se llena después.
+     */
+    EdgeD() {}
 };
 
+typedef EdgeD<2> Edge;
+
 
 /**
- * @class Graph
+ * @class GraphD
  * @brief Representa un grafo completo no dirigido con aristas ponderadas.
  *
- * Dado un conjunto de nodos la clase Graph permite crear todas las aristas posibles entre ellos.
+ * Dado un conjunto de nodos la clase GraphD permite crear todas las aristas posibles entre ellos.
  * También proporciona una función para imprimir la estructura del grafo.
+ * Para nodos de 2 coordenadas se usa el nombre `Graph`.
+ *
+ * @tparam D Número de coordenadas de los nodos.
  */
-class Graph{
+template <int D>
+class GraphD{
+    typedef NodeD<D> Node;
+    typedef EdgeD<D> Edge;
 public:
     std::vector<Node> V; // Lista de nodos
     std::vector<Edge> E; // Lista de aristas
@@ -91,7 +190,8 @@ public:
      *
      * @param Vertices Vector de nodos que compondrán el grafo.
      */
-    Graph(std::vector<Node> Vertices): V(Vertices) { 
+    GraphD(std::vector<Node> Vertices): V(Vertices) { 
+        E.reserve(V.size() * (V.size() - 1) / 2);
         for (int i=0; i<V.size(); i++){
             V[i].id = i; // Asigna un id a cada nodo
             
@@ -102,6 +202,65 @@ public:
         } 
     }
 
+    /**
+     * @brief Constructor del grafo que crea las aristas en paralelo.
+     *
+     * Produce exactamente el mismo grafo que el constructor secuencial, con las aristas en el mismo orden.
+     * El arreglo de aristas se dimensiona de antemano y cada hilo llena un rango disjunto de filas
+     * del triángulo superior; la fila i empieza en la posición i*N - i*(i+1)/2.
+     * Los rangos se eligen para que cada hilo cree aproximadamente la misma cantidad de aristas.
+     *
+     * Si se entrega `espacio`, las aristas se guardan en su memoria cuando su capacidad alcanza, así un
+     * experimento que construye muchos grafos del mismo tamaño reutiliza un solo arreglo (ver `liberarAristas`).
+     *
+     * @param Vertices Vector de nodos que compondrán el grafo.
+     * @param hilos Número de hilos a usar; si es menor que 1 se usa 1.
+     * @param espacio (opcional) Arreglo cuya memoria se reutiliza para las aristas; su contenido se descarta.
+     */
+    GraphD(std::vector<Node> Vertices, int hilos, std::vector<Edge>&& espacio = std::vector<Edge>()): V(Vertices), E(std::move(espacio)) {
+        size_t n = V.size();
+        for (size_t i=0; i<n; i++) V[i].id = i; // Asigna un id a cada nodo
+        E.clear();
+        if (n < 2) return;
+
+        size_t m = n * (n - 1) / 2;
+        E.resize(m);
+        if (hilos < 1) hilos = 1;
+
+        // Crea las aristas de las filas [desde, hasta)
+        auto llenarFilas = [this, n](size_t desde, size_t hasta){
+            size_t k = desde * n - desde * (desde + 1) / 2;
+            for (size_t i=desde; i<hasta; i++){
+                for (size_t j=i+1; j<n; j++) E[k++] = Edge(&V[i], &V[j]);
+            }
+        };
+
+        std::vector<std::thread> trabajadores;
+        size_t fila = 0, creadas = 0;
+        for (int t=0; t<hilos && fila<n; t++){
+            size_t meta = m * (t + 1) / hilos; // aristas acumuladas al terminar este hilo
+            size_t hasta = fila;
+            while (hasta < n && creadas < meta){
+                creadas += n - 1 - hasta;
+                hasta++;
+            }
+            if (t == hilos - 1) hasta = n;
+            trabajadores.push_back(std::thread(llenarFilas, fila, hasta));
+            fila = hasta;
+        }
+        for (std::thread& t : trabajadores) t.join();
+    }
+
+    /**
+     * @brief Entrega el arreglo de aristas, con su memoria, para construir otro grafo sin volver a pedirla.
+     *
+     * El grafo queda sin aristas.
+     */
+    std::vector<Edge> liberarAristas(){
+        std::vector<Edge> espacio = std::move(E);
+        E.clear();
+        return espacio;
+    }
 
     /**
      * @brief Imprime los nodos y aristas del grafo.
@@ -130,7 +289,8 @@ public:
     void print() const {
         std::cout << "\nNodos:" << std::endl;
         for (size_t i = 0; i < V.size(); ++i) {
-            std::cout << "  Nodo " << V[i].id << ":(" << V[i].x << ", " << V[i].y << "), ";
+            std::cout << "  Nodo " << V[i].id << ":(";
+            for (int k=0; k<D; k++) std::cout << V[i][k] << (k + 1 < D ? ", " : "), ");
         }
     
         std::cout << "\nAristas:" << std::endl;
@@ -140,4 +300,62 @@ public:
     }
 };
 
+typedef GraphD<2> Graph;
+
+
+/**
+ * @class ImplicitGraphD
+ * @brief Representa un grafo completo no dirigido sin almacenar sus aristas.
+ *
+ * Solo guarda la lista de nodos; el peso de la arista (i, j) se calcula cuando se necesita.
+ * Usa O(N) memoria en vez de las O(N^2) de `Graph`, lo que permite trabajar con
+ * conjuntos de puntos mucho más grandes. Para nodos de 2 coordenadas se usa el nombre `ImplicitGraph`.
+ *
+ * @tparam D Número de coordenadas de los nodos.
+ */
+template <int D>
+class ImplicitGraphD{
+    typedef NodeD<D> Node;
+    typedef EdgeD<D> Edge;
+public:
+    std::vector<Node> V; // Lista de nodos
+
+    /**
+     * @brief Constructor del grafo implícito.
+     *
+     * Inicializa el grafo con una lista de nodos, asignando un identificador único a cada uno.
+     * No se crea ninguna arista.
+     *
+     * @param Vertices Vector de nodos que compondrán el grafo.
+     */
+    ImplicitGraphD(std::vector<Node> Vertices): V(Vertices) {
+        for (int i=0; i<V.size(); i++) V[i].id = i;
+    }
+
+    /**
+     * @brief Calcula el peso de la arista entre los nodos i y j.
+     *
+     * @param i Identificador del primer nodo.
+     * @param j Identificador del segundo nodo.
+     * @return Cuadrado de la distancia euclidiana entre los nodos.
+     */
+    double peso(int i, int j) const {
+        return distanciaCuadrada(&V[i], &V[j]);
+    }
+
+    /**
+     * @brief Construye la arista entre los nodos i y j.
+     *
+     * La arista queda orientada igual que en `Graph`: `n1` es el nodo de menor id.
+     *
+     * @param i Identificador del primer nodo.
+     * @param j Identificador del segundo nodo.
+     * @return Arista que apunta a los nodos de este grafo.
+     */
+    Edge arista(int i, int j) {
+        if (i > j) std::swap(i, j);
+        return Edge(&V[i], &V[j]);
+    }
+};
 
+typedef ImplicitGraphD<2> ImplicitGraph;
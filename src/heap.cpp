@@ -0,0 +1,111 @@
+#pragma once
+#include <algorithm>    // std::min
+#include <cstdint>
+#include <vector>
+#include "arena.cpp"
+
+/**
+ * @brief Métodos disponibles para el heap de las variantes de Kruskal con heap.
+ */
+enum MetodoHeap {
+    HEAP_STD,     // std::priority_queue sobre copias de `Edge`
+    HEAP_4ARIO,   // heap 4-ario implícito sobre claves (peso, índice)
+    HEAP_8ARIO    // heap 8-ario implícito sobre claves (peso, índice)
+};
+
+/**
+ * @brief Nombre del método de heap, para mostrarlo en los resultados.
+ */
+const char* nombreHeap(MetodoHeap metodo){
+    switch (metodo){
+        case HEAP_4ARIO: return "heap 4-ario";
+        case HEAP_8ARIO: return "heap 8-ario";
+        default: return "std::priority_queue";
+    }
+}
+
+/**
+ * @brief Clave compacta de una arista: su peso y su posición en la lista de aristas del grafo.
+ *
+ * Ocupa 16 bytes, en vez de los 24 de una copia de `Edge`. El índice es de 64 bits porque un índice
+ * de 32 bits ocuparía lo mismo por la alineación del peso, y así sirve para grafos de más de 2^32 aristas.
+ */
+struct ClaveArista {
+    double peso;
+    uint64_t indice;
+};
+
+static_assert(sizeof(ClaveArista) == 16, "la clave debe ocupar 16 bytes");
+
+/**
+ * @class HeapDario
+ * @brief Heap de mínimos D-ario implícito sobre claves de aristas.
+ *
+ * Los hijos del elemento i están en las posiciones D*i+1, ..., D*i+D. Con D = 4 u 8 los hijos
+ * de un nodo caben en una o dos líneas de caché, y el árbol es mucho menos profundo que un heap binario,
+ * por lo que cada `pop` toca menos memoria.
+ *
+ * El heap se construye en su lugar sobre el arreglo recibido (heapify de Floyd), sin copiarlo.
+ *
+ * @tparam D Número de hijos de cada nodo.
+ */
+template <int D>
+class HeapDario {
+    VectorArena<ClaveArista> claves;
+
+    /**
+     * @brief Baja la clave `c` desde la posición `i` hasta su lugar, moviendo un hueco en vez de hacer swaps.
+     */
+    void hundir(size_t i, ClaveArista c){
+        size_t n = claves.size();
+        while (true){
+            size_t primero = D * i + 1;
+            if (primero >= n) break;
+            size_t ultimo = std::min(primero + D, n);
+
+            size_t menor = primero;
+            for (size_t k=primero+1; k<ultimo; k++){
+                if (claves[k].peso < claves[menor].peso) menor = k;
+            }
+            if (!(claves[menor].peso < c.peso)) break;
+            claves[i] = claves[menor];
+            i = menor;
+        }
+        claves[i] = c;
+    }
+
+public:
+    /**
+     * @brief Construye el heap tomando posesión del arreglo de claves.
+     *
+     * @param arreglo Claves de las aristas, en cualquier orden.
+     */
+    HeapDario(VectorArena<ClaveArista>&& arreglo) : claves(std::move(arreglo)) {
+        if (claves.size() < 2) return;
+        for (size_t i=(claves.size() - 2) / D + 1; i-- > 0; ) hundir(i, claves[i]);
+    }
+
+    /**
+     * @brief Indica si el heap no tiene claves.
+     */
+    bool empty() const { return claves.empty(); }
+
+    /**
+     * @brief Número de claves en el heap.
+     */
+    size_t size() const { return claves.size(); }
+
+    /**
+     * @brief Clave de menor peso.
+     */
+    const ClaveArista& top() const { return claves[0]; }
+
+    /**
+     * @brief Elimina la clave de menor peso.
+     */
+    void pop(){
+        ClaveArista ultima = claves.back();
+        claves.pop_back();
+        if (!claves.empty()) hundir(0, ultima);
+    }
+};
@@ -0,0 +1,415 @@
+#pragma once
+#include <algorithm>    // std::sort, std::find
+#include <cmath>        // std::atan2
+#include "UnionFind.cpp"
+#include "enlaceCorte.cpp"
+#include "geometrico.cpp"
+#include "kdtree.cpp"
+
+/**
+ * @class MSTIncremental
+ * @brief Mantiene el MST euclidiano de un conjunto de puntos del plano que cambia, sin recalcularlo desde cero.
+ *
+ * Los puntos activos se guardan en un `KDTreeDinamico` y el árbol en un `ArbolEnlaceCorte`, que da la
+ * arista más pesada del camino entre dos puntos en O(log N) amortizado.
+ * - Inserción: los puntos de un lote se insertan de a uno. Si se divide el plano alrededor del punto nuevo p
+ *   en 8 sectores de 45°, basta con la arista al punto más cercano de cada sector (y a un punto repetido,
+ *   si hay): para otro punto v del sector, el más cercano w cumple |wv| < |pv|, así que p-w-v es un camino
+ *   sin aristas más pesadas que (p, v) y (p, v) no hace falta. Cada arista candidata se agrega con la
+ *   propiedad del ciclo: si es más liviana que la más pesada del camino entre sus extremos, la reemplaza.
+ * - Eliminación: al quitar un punto el árbol se separa en tantos subárboles como vecinos tenía (a lo más
+ *   6 en el plano salvo puntos repetidos), que siguen siendo parte del nuevo MST. Se vuelven a unir con
+ *   rondas de Borůvka que solo buscan desde los subárboles más chicos, y en ellos desde los puntos unidos
+ *   al punto eliminado por caminos más livianos que la arista que se busca (ver `reconectar`).
+ *
+ * Con puntos uniformes, insertar un lote de B puntos toma O(B log N) esperado y eliminar un punto toma
+ * O(S + R log N), con S el tamaño de los subárboles más chicos que deja y R los puntos desde los que se
+ * busca, en vez de los O(N log N) de volver a calcular el MST con `kruskal_geometrico`.
+ * La memoria es O(N) en los puntos activos: los ids de los puntos eliminados se reutilizan en las
+ * inserciones siguientes.
+ *
+ * ### Ejemplo de uso:
+ * @code
+ * MSTIncremental mst(generarPuntos(1000, 1));
+ * int id = mst.insertar(Node(0.5, 0.5));
+ * mst.eliminar(id);
+ * std::vector<Edge> aristas = mst.aristas();
+ * @endcode
+ */
+class MSTIncremental {
+    struct AristaArbol {
+        double peso;
+        int a, b;
+    };
+
+    struct Vecino {
+        int id;
+        int arista;  // nodo de la arista en `enlaces`
+    };
+
+    static constexpr int SECTORES = 8;
+    static constexpr double GIRO = 0.3;  // ángulo del primer sector; evita que las rectas de una grilla queden en un borde
+
+    std::vector<Node> V;                          // Puntos por id; `V[i].id` es `i`
+    std::vector<bool> activo;                     // false para los ids libres
+    std::vector<int> libres;                      // Ids de puntos eliminados, para reutilizarlos
+    std::vector<int> lista;                       // Ids de los puntos activos
+    std::vector<int> posicionLista;               // Posición de cada id activo en `lista`
+    std::vector<std::vector<Vecino>> adyacencia;  // Vecinos de cada punto en el MST
+    std::vector<int> nodoPunto;                   // Nodo de cada punto en `enlaces`
+    std::vector<AristaArbol> aristaNodo;          // Arista que representa cada nodo de `enlaces`
+    std::vector<int> etiqueta;                    // Subárbol de cada punto al eliminar, -1 fuera de eso
+    ArbolEnlaceCorte enlaces;
+    KDTreeDinamico<2> kd;
+
+    /**
+     * @brief Sector de la dirección de `p` a `q`, en [0, SECTORES).
+     */
+    static int sector(double dx, double dy){
+        const double ANCHO = 2 * M_PI / SECTORES;
+        double angulo = std::atan2(dy, dx) - GIRO;
+        if (angulo < 0) angulo += 2 * M_PI;
+        return std::min((int)(angulo / ANCHO), SECTORES - 1);
+    }
+
+    /**
+     * @brief Sectores, alrededor de `p`, que puede cortar una caja; bit `s` para el sector `s`.
+     *
+     * Si la caja no contiene a `p`, sus direcciones desde `p` forman un intervalo de menos de 180° limitado
+     * por dos esquinas. Se agranda un poco para que incluya siempre el sector que `sector` le asigna a cada
+     * punto de la caja.
+     */
+    static int sectoresCaja(const Node& p, const double* min, const double* max){
+        if (p.x >= min[0] && p.x <= max[0] && p.y >= min[1] && p.y <= max[1]) return (1 << (SECTORES + 1)) - 1;
+        const double ANCHO = 2 * M_PI / SECTORES, MARGEN = 1e-9;
+        double referencia = std::atan2((min[1] + max[1]) / 2 - p.y, (min[0] + max[0]) / 2 - p.x);
+        double desde = M_PI, hasta = -M_PI;
+        for (double x : {min[0], max[0]}){
+            for (double y : {min[1], max[1]}){
+                double angulo = std::atan2(y - p.y, x - p.x) - referencia;
+                if (angulo > M_PI) angulo -= 2 * M_PI; else if (angulo < -M_PI) angulo += 2 * M_PI;
+                desde = std::min(desde, angulo);
+                hasta = std::max(hasta, angulo);
+            }
+        }
+        double inicio = referencia + desde - MARGEN - GIRO;
+        while (inicio < 0) inicio += 2 * M_PI;
+        int primero = inicio / ANCHO;
+        int ultimo = (inicio + (hasta - desde) + 2 * MARGEN) / ANCHO;
+        int mascara = 0;
+        for (int s=primero; s<=ultimo; s++) mascara |= 1 << (s % SECTORES);
+        return mascara;
+    }
+
+    /**
+     * @brief Aristas candidatas de un punto nuevo: al más cercano de cada sector y a un punto repetido.
+     *
+     * Solo considera los puntos que ya están en el árbol k-d.
+     */
+    std::vector<AristaArbol> candidatasSectores(int id) const {
+        const Node& p = V[id];
+        // El sector SECTORES guarda los puntos repetidos, que no tienen dirección
+        double mejorPeso[SECTORES + 1];
+        int mejor[SECTORES + 1];
+        std::fill(mejorPeso, mejorPeso + SECTORES + 1, std::numeric_limits<double>::infinity());
+        std::fill(mejor, mejor + SECTORES + 1, -1);
+
+        kd.buscar(p,
+            [&](const double* min, const double* max, double distancia){
+                int mascara = sectoresCaja(p, min, max);
+                for (int s=0; s<=SECTORES; s++) if ((mascara >> s & 1) && distancia <= mejorPeso[s]) return false;
+                return true;
+            },
+            [&](int j){
+                const Node& q = V[j];
+                int s = (q.x == p.x && q.y == p.y) ? SECTORES : sector(q.x - p.x, q.y - p.y);
+                double d = distanciaCuadrada(&p, &q);
+                if (d < mejorPeso[s]){
+                    mejorPeso[s] = d;
+                    mejor[s] = j;
+                }
+            });
+
+        std::vector<AristaArbol> candidatas;
+        for (int s=0; s<=SECTORES; s++) if (mejor[s] != -1) candidatas.push_back({mejorPeso[s], id, mejor[s]});
+        std::sort(candidatas.begin(), candidatas.end(), [](const AristaArbol& x, const AristaArbol& y){ return x.peso < y.peso; });
+        return candidatas;
+    }
+
+    /**
+     * @brief Agrega al MST la arista entre `a` y `b`, que deben estar en árboles distintos.
+     */
+    void unir(int a, int b, double peso){
+        int e = enlaces.agregarNodo(peso);
+        if (e >= (int)aristaNodo.size()) aristaNodo.resize(e + 1);
+        aristaNodo[e] = {peso, a, b};
+        enlaces.enlazar(nodoPunto[a], e);
+        enlaces.enlazar(e, nodoPunto[b]);
+        adyacencia[a].push_back({b, e});
+        adyacencia[b].push_back({a, e});
+    }
+
+    /**
+     * @brief Quita del MST la arista representada por el nodo `e` de `enlaces`.
+     */
+    void separar(int e){
+        int a = aristaNodo[e].a, b = aristaNodo[e].b;
+        enlaces.cortar(nodoPunto[a], e);
+        enlaces.cortar(e, nodoPunto[b]);
+        enlaces.liberarNodo(e);
+        for (int x : {a, b}){
+            std::vector<Vecino>& vecinos = adyacencia[x];
+            for (Vecino& v : vecinos){
+                if (v.arista == e){
+                    v = vecinos.back();
+                    vecinos.pop_back();
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Guarda un punto nuevo, todavía sin aristas ni lugar en el árbol k-d.
+     *
+     * @return Id asignado: uno libre si hay, si no el siguiente.
+     */
+    int agregarPunto(const Node& p){
+        int id;
+        if (libres.empty()){
+            id = V.size();
+            V.push_back(p);
+            activo.push_back(true);
+            posicionLista.push_back(0);
+            adyacencia.emplace_back();
+            nodoPunto.push_back(0);
+            etiqueta.push_back(-1);
+        } else {
+            id = libres.back();
+            libres.pop_back();
+            V[id] = p;
+            activo[id] = true;
+        }
+        V[id].id = id;
+        posicionLista[id] = lista.size();
+        lista.push_back(id);
+        nodoPunto[id] = enlaces.agregarNodo(-std::numeric_limits<double>::infinity());
+        return id;
+    }
+
+    /**
+     * @brief Vuelve a unir los subárboles que quedan al eliminar un punto, con rondas de Borůvka.
+     *
+     * Los subárboles se recorren a la par desde los vecinos hasta que solo queda uno sin terminar, el más
+     * grande, cuyos puntos no recorridos quedan con etiqueta -1. Como en `unirComponentesGeometrico`, no se
+     * busca la arista de la componente del subárbol más grande: las demás la unen a algo en cada ronda.
+     *
+     * Por la propiedad del ciclo en el MST anterior, una arista (i, j) que sale del subárbol de i pesa al
+     * menos lo que la más pesada del camino de i al punto eliminado. Por eso solo se busca desde los puntos
+     * cuyo camino no es más pesado que la mejor arista encontrada para su componente.
+     *
+     * @param vecinos Vecinos que tenía el punto eliminado, cuyas aristas ya se quitaron.
+     * @param pesos Peso de la arista entre el punto eliminado y cada vecino.
+     */
+    void reconectar(const std::vector<int>& vecinos, const std::vector<double>& pesos){
+        int k = vecinos.size();
+        std::vector<std::vector<int>> subarbol(k);
+        std::vector<std::vector<double>> maximo(k); // arista más pesada del camino de cada punto al eliminado
+        std::vector<size_t> siguiente(k, 0);
+        for (int c=0; c<k; c++){
+            subarbol[c].push_back(vecinos[c]);
+            maximo[c].push_back(pesos[c]);
+            etiqueta[vecinos[c]] = c;
+        }
+        int abiertos = k;
+        for (int c=0; abiertos > 1; c = (c + 1) % k){
+            if (siguiente[c] == subarbol[c].size()) continue;
+            size_t u = siguiente[c]++;
+            for (const Vecino& v : adyacencia[subarbol[c][u]]){
+                if (etiqueta[v.id] == -1){
+                    etiqueta[v.id] = c;
+                    subarbol[c].push_back(v.id);
+                    maximo[c].push_back(std::max(maximo[c][u], aristaNodo[v.arista].peso));
+                }
+            }
+            if (siguiente[c] == subarbol[c].size()) abiertos--;
+        }
+        int grande = 0;
+        while (siguiente[grande] == subarbol[grande].size()) grande++;
+
+        UnionFind uf(k);
+        auto componente = [&](int j){ return uf.find(etiqueta[j] == -1 ? grande : etiqueta[j]); };
+        std::vector<double> mejorPeso(k);
+        std::vector<int> mejorA(k), mejorB(k);
+        auto mejora = [&](int r, double d, int a, int b){
+            if (a > b) std::swap(a, b);
+            if (d < mejorPeso[r] || (d == mejorPeso[r] && (a < mejorA[r] || (a == mejorA[r] && b < mejorB[r])))){
+                mejorPeso[r] = d;
+                mejorA[r] = a;
+                mejorB[r] = b;
+            }
+        };
+
+        for (int restantes=k; restantes > 1; ){
+            int raizGrande = uf.find(grande);
+            // La arista entre el vecino de cada subárbol y el del más grande cruza el corte y acota la búsqueda
+            std::fill(mejorPeso.begin(), mejorPeso.end(), std::numeric_limits<double>::infinity());
+            for (int c=0; c<k; c++){
+                int r = uf.find(c);
+                if (r != raizGrande) mejora(r, distanciaCuadrada(&V[vecinos[c]], &V[vecinos[grande]]), vecinos[c], vecinos[grande]);
+            }
+            for (int c=0; c<k; c++){
+                int r = uf.find(c);
+                if (r == raizGrande) continue;
+                for (size_t u=0; u<subarbol[c].size(); u++){
+                    if (maximo[c][u] > mejorPeso[r]) continue;
+                    int i = subarbol[c][u];
+                    const Node& p = V[i];
+                    kd.buscar(p,
+                        [&](const double*, const double*, double distancia){ return distancia > mejorPeso[r]; },
+                        [&](int j){ if (componente(j) != r) mejora(r, distanciaCuadrada(&p, &V[j]), i, j); });
+                }
+            }
+            // Con el orden total (peso, id menor, id mayor) las aristas elegidas no forman ciclos
+            for (int c=0; c<k; c++){
+                if (uf.find(c) != c || c == raizGrande) continue;
+                int raiz_x = componente(mejorA[c]);
+                int raiz_y = componente(mejorB[c]);
+                if (raiz_x != raiz_y){ // dos componentes pueden elegir la misma arista
+                    uf.union_(raiz_x, raiz_y);
+                    unir(mejorA[c], mejorB[c], mejorPeso[c]);
+                    restantes--;
+                }
+            }
+        }
+        for (const std::vector<int>& puntos : subarbol) for (int i : puntos) etiqueta[i] = -1;
+    }
+
+public:
+    /**
+     * @brief Crea una estructura sin puntos.
+     */
+    MSTIncremental() : kd(V) {}
+
+    /**
+     * @brief Crea la estructura con un conjunto inicial de puntos, cuyo MST se calcula con `kruskal_geometrico`.
+     *
+     * Los puntos reciben los ids 0, ..., N-1 en el orden entregado.
+     */
+    MSTIncremental(const std::vector<Node>& puntos) : kd(V) {
+        for (const Node& p : puntos) agregarPunto(p);
+        for (const Edge& e : kruskal_geometrico(V)) unir(e.n1->id, e.n2->id, e.peso);
+        kd.reconstruir(lista);
+    }
+
+    // El árbol k-d guarda una referencia a `V`
+    MSTIncremental(const MSTIncremental&) = delete;
+    MSTIncremental& operator=(const MSTIncremental&) = delete;
+
+    /**
+     * @brief Inserta un lote de puntos y actualiza el MST.
+     *
+     * Cada punto se compara solo con los más cercanos por sector entre los puntos activos y los anteriores
+     * del lote (ver `candidatasSectores`).
+     *
+     * @param lote Puntos por insertar.
+     * @return Ids asignados a los puntos, en el mismo orden.
+     */
+    std::vector<int> insertar(const std::vector<Node>& lote){
+        std::vector<int> ids;
+        for (const Node& p : lote){
+            int id = agregarPunto(p);
+            ids.push_back(id);
+            std::vector<AristaArbol> candidatas = candidatasSectores(id);
+            kd.insertar(id);
+            for (size_t k=0; k<candidatas.size(); k++){
+                const AristaArbol& e = candidatas[k];
+                if (k == 0){ // el punto todavía está aislado
+                    unir(e.a, e.b, e.peso);
+                    continue;
+                }
+                int maximo = enlaces.maximoCamino(nodoPunto[e.a], nodoPunto[e.b]);
+                if (e.peso < enlaces.valor(maximo)){
+                    separar(maximo);
+                    unir(e.a, e.b, e.peso);
+                }
+            }
+        }
+        return ids;
+    }
+
+    /**
+     * @brief Inserta un punto y actualiza el MST.
+     *
+     * @return Id asignado al punto.
+     */
+    int insertar(const Node& p){
+        return insertar(std::vector<Node>{p})[0];
+    }
+
+    /**
+     * @brief Elimina un punto y actualiza el MST.
+     *
+     * Se quitan las aristas del punto y los subárboles que quedan se vuelven a unir (ver `reconectar`).
+     * El id queda libre para una inserción posterior.
+     *
+     * @param id Id del punto.
+     * @return false si el id no corresponde a un punto activo.
+     */
+    bool eliminar(int id){
+        if (!estaActivo(id)) return false;
+        std::vector<int> vecinos;
+        std::vector<double> pesos;
+        while (!adyacencia[id].empty()){
+            vecinos.push_back(adyacencia[id].back().id);
+            pesos.push_back(aristaNodo[adyacencia[id].back().arista].peso);
+            separar(adyacencia[id].back().arista);
+        }
+        kd.eliminar(id);
+        enlaces.liberarNodo(nodoPunto[id]);
+        activo[id] = false;
+        lista[posicionLista[id]] = lista.back();
+        posicionLista[lista.back()] = posicionLista[id];
+        lista.pop_back();
+        if (vecinos.size() > 1) reconectar(vecinos, pesos);
+        libres.push_back(id);
+        return true;
+    }
+
+    /**
+     * @brief Número de puntos activos.
+     */
+    int size() const { return lista.size(); }
+
+    /**
+     * @brief Peso total del MST actual.
+     */
+    double peso() const {
+        double total = 0;
+        for (int a : lista) for (const Vecino& v : adyacencia[a]) if (a < v.id) total += aristaNodo[v.arista].peso;
+        return total;
+    }
+
+    /**
+     * @brief Puntos por id, incluidos los ids libres; `nodos()[i].id` es `i`.
+     */
+    const std::vector<Node>& nodos() const { return V; }
+
+    /**
+     * @brief Indica si el punto `id` está activo.
+     */
+    bool estaActivo(int id) const { return id >= 0 && id < (int)V.size() && activo[id]; }
+
+    /**
+     * @brief Aristas del MST actual ordenadas por peso.
+     *
+     * Apuntan a los nodos de esta estructura, por lo que dejan de ser válidas al insertar puntos.
+     */
+    std::vector<Edge> aristas(){
+        std::vector<Edge> result;
+        result.reserve(lista.empty() ? 0 : lista.size() - 1);
+        for (int a : lista) for (const Vecino& v : adyacencia[a]) if (a < v.id) result.push_back(Edge(&V[a], &V[v.id]));
+        std::sort(result.begin(), result.end(), sortByWeight);
+        return result;
+    }
+};
@@ -0,0 +1,253 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifdef INSTRUMENTACION
+#include <cstring>          // std::memset
+#include <iostream>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Medición de las etapas internas de las variantes de Kruskal.
+//
+// Los tiempos por etapa y el número de aristas ordenadas siempre están disponibles. Al compilar con
+// -DINSTRUMENTACION se agregan contadores de hardware (ciclos, fallos de caché y de predicción de saltos,
+// leídos con perf_event_open) por etapa y contadores de software (aristas examinadas, llamadas a find,
+// largo de los caminos recorridos y uniones). Sin esa opción los contadores no existen y `CONTAR` no genera código.
+
+#ifdef INSTRUMENTACION
+/**
+ * @brief Contadores de hardware acumulados en una etapa.
+ */
+struct ContadoresHardware {
+    uint64_t ciclos = 0;
+    uint64_t fallosCache = 0;
+    uint64_t fallosSalto = 0;  // saltos mal predichos
+};
+
+/**
+ * @brief Contadores de operaciones de una ejecución.
+ *
+ * Solo se cuentan las operaciones del hilo que ejecuta la variante y de `UnionFindPolitica`;
+ * el `ConcurrentUnionFind` y los hilos de ordenamiento no se cuentan.
+ */
+struct ContadoresSoftware {
+    uint64_t aristasExaminadas = 0;  // aristas consideradas por Kruskal o descartadas por el filtro
+    uint64_t llamadasFind = 0;
+    uint64_t largoCaminos = 0;       // enlaces recorridos por find hasta llegar a la raíz
+    uint64_t uniones = 0;
+};
+#endif
+
+/**
+ * @brief Tiempos, en segundos, de las etapas internas de una variante de Kruskal.
+ */
+struct TiemposFases {
+    double copia = 0;      // copia de las aristas del grafo
+    double orden = 0;      // ordenamiento de las aristas o construcción del heap
+    double unionFind = 0;  // recorrido de las aristas con el Union-Find (en los heaps incluye los pop)
+    uint64_t aristasOrdenadas = 0;  // aristas que pasaron por un ordenamiento completo (ver `contarOrdenadas`)
+#ifdef INSTRUMENTACION
+    ContadoresHardware hwCopia, hwOrden, hwUnionFind;
+    ContadoresSoftware software;
+#endif
+};
+
+/**
+ * @brief Si no es nulo, las variantes de Kruskal acumulan aquí el tiempo de cada etapa.
+ *
+ * Lo activa el benchmark antes de ejecutar una variante; fuera de él queda nulo y medir no cuesta nada.
+ * Es local a cada hilo, para que `LoteMST` mida por separado los trabajos que resuelve cada hilo.
+ */
+thread_local TiemposFases* fasesActivas = nullptr;
+
+/**
+ * @brief Suma `cantidad` a las aristas ordenadas de las fases activas, si las hay.
+ *
+ * Se llama una vez por cada arreglo o bloque que se ordena completo. A diferencia de `CONTAR`, no depende
+ * de -DINSTRUMENTACION: cuesta una comparación por ordenamiento y permite ver cuánto ordenan las
+ * variantes que ordenan por partes en cualquier compilación.
+ */
+inline void contarOrdenadas(size_t cantidad){
+    if (fasesActivas) fasesActivas->aristasOrdenadas += cantidad;
+}
+
+#ifdef INSTRUMENTACION
+/**
+ * @brief Suma `cantidad` al contador de software `campo` de las fases activas.
+ */
+#define CONTAR(campo, cantidad) do { if (fasesActivas) fasesActivas->software.campo += (cantidad); } while (0)
+
+/**
+ * @class ContadoresPerf
+ * @brief Grupo de contadores de hardware del hilo actual, abierto con perf_event_open.
+ *
+ * Los tres eventos se abren como un grupo para que se lean juntos y cubran el mismo intervalo.
+ * Si el sistema no permite abrirlos (por ejemplo con `perf_event_paranoid` alto o dentro de un contenedor)
+ * se avisa una vez y todas las lecturas son 0.
+ */
+class ContadoresPerf {
+    int lider = -1;
+    std::vector<int> descriptores;
+
+    int abrir(uint64_t config, int grupo){
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.read_format = PERF_FORMAT_GROUP;
+        attr.disabled = grupo == -1;  // el grupo se activa completo desde el líder
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return syscall(SYS_perf_event_open, &attr, 0, -1, grupo, 0);
+    }
+
+public:
+    ContadoresPerf(){
+        lider = abrir(PERF_COUNT_HW_CPU_CYCLES, -1);
+        if (lider == -1){
+            std::cerr << "Aviso: no se pudieron abrir los contadores de hardware; se reportarán en 0\n";
+            return;
+        }
+        descriptores.push_back(lider);
+        for (uint64_t config : {PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES}){
+            int fd = abrir(config, lider);
+            if (fd == -1){
+                std::cerr << "Aviso: contadores de hardware incompletos; se reportarán en 0\n";
+                cerrar();
+                return;
+            }
+            descriptores.push_back(fd);
+        }
+        ioctl(lider, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(lider, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    ~ContadoresPerf(){ cerrar(); }
+
+    void cerrar(){
+        for (int fd : descriptores) close(fd);
+        descriptores.clear();
+        lider = -1;
+    }
+
+    /**
+     * @brief Lee los valores acumulados desde que se abrió el grupo.
+     */
+    ContadoresHardware leer() const {
+        ContadoresHardware c;
+        if (lider == -1) return c;
+        uint64_t buffer[4]; // número de eventos, seguido del valor de cada uno
+        if (read(lider, buffer, sizeof(buffer)) != sizeof(buffer)) return c;
+        c.ciclos = buffer[1];
+        c.fallosCache = buffer[2];
+        c.fallosSalto = buffer[3];
+        return c;
+    }
+
+    /**
+     * @brief Contadores del hilo actual; se abren la primera vez que se usan.
+     */
+    static const ContadoresPerf& delHilo(){
+        thread_local ContadoresPerf perf;
+        return perf;
+    }
+};
+#else
+#define CONTAR(campo, cantidad) ((void)0)
+#endif
+
+/**
+ * @brief Mide el tiempo de una etapa de una variante de Kruskal.
+ *
+ * Se crea al empezar la etapa y `terminar` suma el tiempo transcurrido al campo indicado de
+ * `fasesActivas`. Solo se lee el reloj si hay fases activas. Con instrumentación, también suma
+ * los contadores de hardware de la etapa.
+ *
+ * ### Ejemplo de uso:
+ * @code
+ * MedidorFase medidor;
+ * std::sort(edges.begin(), edges.end(), sortByWeight);
+ * medidor.terminar(&TiemposFases::orden);
+ * @endcode
+ */
+class MedidorFase {
+    std::chrono::steady_clock::time_point inicio;
+#ifdef INSTRUMENTACION
+    ContadoresHardware inicioHw;
+#endif
+public:
+    MedidorFase(){
+        if (!fasesActivas) return;
+#ifdef INSTRUMENTACION
+        inicioHw = ContadoresPerf::delHilo().leer();
+#endif
+        inicio = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Suma el tiempo desde la creación (o el último `terminar`) a la etapa indicada y reinicia la medición.
+     *
+     * @param fase Campo de `TiemposFases` al que se suma el tiempo.
+     */
+    void terminar(double TiemposFases::* fase){
+        if (!fasesActivas) return;
+        auto ahora = std::chrono::steady_clock::now();
+        fasesActivas->*fase += std::chrono::duration<double>(ahora - inicio).count();
+        inicio = ahora;
+#ifdef INSTRUMENTACION
+        ContadoresHardware hw = ContadoresPerf::delHilo().leer();
+        ContadoresHardware& destino = fase == &TiemposFases::copia ? fasesActivas->hwCopia
+                                    : fase == &TiemposFases::orden ? fasesActivas->hwOrden
+                                    : fasesActivas->hwUnionFind;
+        destino.ciclos += hw.ciclos - inicioHw.ciclos;
+        destino.fallosCache += hw.fallosCache - inicioHw.fallosCache;
+        destino.fallosSalto += hw.fallosSalto - inicioHw.fallosSalto;
+        inicioHw = hw;
+#endif
+    }
+};
+
+/**
+ * @brief Nombres de las columnas extra que agrega la instrumentación a los CSV, en el orden de `valoresContadores`.
+ *
+ * @return Vector vacío si se compiló sin instrumentación.
+ */
+std::vector<std::string> columnasContadores(){
+#ifdef INSTRUMENTACION
+    return {"ciclos_copia", "fallos_cache_copia", "fallos_salto_copia",
+            "ciclos_orden", "fallos_cache_orden", "fallos_salto_orden",
+            "ciclos_union_find", "fallos_cache_union_find", "fallos_salto_union_find",
+            "aristas_examinadas", "llamadas_find", "largo_caminos", "uniones"};
+#else
+    return {};
+#endif
+}
+
+/**
+ * @brief Valores de los contadores de una ejecución, en el orden de `columnasContadores`.
+ */
+std::vector<double> valoresContadores(const TiemposFases& fases){
+#ifdef INSTRUMENTACION
+    std::vector<double> v;
+    for (const ContadoresHardware* hw : {&fases.hwCopia, &fases.hwOrden, &fases.hwUnionFind}){
+        v.push_back(hw->ciclos);
+        v.push_back(hw->fallosCache);
+        v.push_back(hw->fallosSalto);
+    }
+    v.push_back(fases.software.aristasExaminadas);
+    v.push_back(fases.software.llamadasFind);
+    v.push_back(fases.software.largoCaminos);
+    v.push_back(fases.software.uniones);
+    return v;
+#else
+    (void)fases;
+    return {};
+#endif
+}
@@ -0,0 +1,395 @@
+#pragma once
+#include <algorithm>    // std::nth_element
+#include <limits>
+#include "graph.cpp"
+
+/**
+ * @class KDTree
+ * @brief Árbol k-d balanceado sobre los nodos de un grafo.
+ *
+ * Se construye una sola vez sobre un vector de nodos (cuyo `id` debe coincidir con su posición)
+ * y permite buscar, para un nodo, el nodo más cercano que pertenece a otra componente.
+ * Cada nodo del árbol guarda su caja envolvente y, si todos sus puntos están en la misma
+ * componente, la etiqueta de esa componente, lo que permite descartar subárboles completos.
+ *
+ * @tparam D Número de coordenadas de los nodos.
+ */
+template <int D>
+class KDTree {
+    typedef NodeD<D> Node;
+
+    struct Celda {
+        double min[D], max[D];         // caja envolvente de los puntos de la celda
+        int inicio, fin;               // rango [inicio, fin) en `indices`
+        int izq, der;                  // hijos, -1 si es hoja
+        int componente;                // componente común a todos sus puntos, -1 si hay varias
+    };
+
+    const std::vector<Node>& V;  // Nodos sobre los que se construye el árbol
+    std::vector<int> indices;    // Permutación de los ids de los nodos
+    std::vector<Celda> celdas;   // Celdas del árbol, la raíz es la 0
+    static const int TAM_HOJA = 8;
+
+    /**
+     * @brief Construye recursivamente la celda que cubre `indices[inicio, fin)`.
+     *
+     * Divide por la mediana en la coordenada de mayor extensión.
+     *
+     * @return Posición de la celda creada en `celdas`.
+     */
+    int construir(int inicio, int fin){
+        Celda c;
+        for (int d=0; d<D; d++){
+            c.min[d] = std::numeric_limits<double>::infinity();
+            c.max[d] = -std::numeric_limits<double>::infinity();
+        }
+        for (int k=inicio; k<fin; k++){
+            const Node& p = V[indices[k]];
+            for (int d=0; d<D; d++){
+                c.min[d] = std::min(c.min[d], p[d]);
+                c.max[d] = std::max(c.max[d], p[d]);
+            }
+        }
+        c.inicio = inicio;
+        c.fin = fin;
+        c.izq = c.der = -1;
+        c.componente = -1;
+
+        int pos = celdas.size();
+        celdas.push_back(c);
+        if (fin - inicio <= TAM_HOJA) return pos;
+
+        int eje = 0;
+        for (int d=1; d<D; d++){
+            if (c.max[d] - c.min[d] > c.max[eje] - c.min[eje]) eje = d;
+        }
+        int medio = (inicio + fin) / 2;
+        std::nth_element(indices.begin() + inicio, indices.begin() + medio, indices.begin() + fin,
+            [&](int a, int b){ return V[a][eje] < V[b][eje]; });
+
+        int izq = construir(inicio, medio);
+        int der = construir(medio, fin);
+        celdas[pos].izq = izq; // push_back puede invalidar referencias, se accede por posición
+        celdas[pos].der = der;
+        return pos;
+    }
+
+    /**
+     * @brief Cota inferior del peso entre un nodo y cualquier punto de una celda.
+     */
+    static double distanciaCaja(const Node& p, const Celda& c){
+        double suma = 0;
+        for (int d=0; d<D; d++){
+            double dx = 0;
+            if (p[d] < c.min[d]) dx = c.min[d] - p[d]; else if (p[d] > c.max[d]) dx = p[d] - c.max[d];
+            suma += dx*dx;
+        }
+        return suma;
+    }
+
+    /**
+     * @brief Recalcula la componente común de la celda `pos` y sus descendientes.
+     */
+    int etiquetar(int pos, const std::vector<int>& componente){
+        Celda& c = celdas[pos];
+        if (c.izq == -1){
+            int comp = componente[indices[c.inicio]];
+            for (int k=c.inicio+1; k<c.fin && comp != -1; k++){
+                if (componente[indices[k]] != comp) comp = -1;
+            }
+            c.componente = comp;
+        } else {
+            int a = etiquetar(c.izq, componente);
+            int b = etiquetar(c.der, componente);
+            celdas[pos].componente = (a == b) ? a : -1;
+        }
+        return celdas[pos].componente;
+    }
+
+    /**
+     * @brief Búsqueda recursiva de `vecinoFuera` a partir de la celda `pos`.
+     */
+    void buscar(int pos, int i, int comp, const std::vector<int>& componente,
+                double& mejorPeso, int& mejorA, int& mejorB) const {
+        const Celda& c = celdas[pos];
+        if (c.componente == comp) return; // todo el subárbol está en la misma componente
+        const Node& p = V[i];
+        if (distanciaCaja(p, c) > mejorPeso) return;
+
+        if (c.izq == -1){
+            for (int k=c.inicio; k<c.fin; k++){
+                int j = indices[k];
+                if (componente[j] == comp) continue;
+                double d = distanciaCuadrada(&p, &V[j]);
+                int a = std::min(i, j), b = std::max(i, j);
+                if (d < mejorPeso || (d == mejorPeso && (a < mejorA || (a == mejorA && b < mejorB)))){
+                    mejorPeso = d;
+                    mejorA = a;
+                    mejorB = b;
+                }
+            }
+            return;
+        }
+
+        // Se visita primero el hijo más cercano para acotar antes la búsqueda
+        int primero = c.izq, segundo = c.der;
+        if (distanciaCaja(p, celdas[segundo]) < distanciaCaja(p, celdas[primero])) std::swap(primero, segundo);
+        buscar(primero, i, comp, componente, mejorPeso, mejorA, mejorB);
+        buscar(segundo, i, comp, componente, mejorPeso, mejorA, mejorB);
+    }
+
+public:
+    /**
+     * @brief Construye el árbol sobre los nodos entregados.
+     *
+     * @param Vertices Nodos del grafo; `Vertices[i].id` debe ser `i`.
+     */
+    KDTree(const std::vector<Node>& Vertices) : V(Vertices) {
+        indices.resize(V.size());
+        for (int i=0; i<V.size(); i++) indices[i] = i;
+        if (!V.empty()) construir(0, V.size());
+    }
+
+    /**
+     * @brief Actualiza las etiquetas de componente de las celdas.
+     *
+     * Debe llamarse cada vez que cambian las componentes, antes de `vecinoFuera`.
+     *
+     * @param componente Componente de cada nodo, indexado por id.
+     */
+    void actualizarComponentes(const std::vector<int>& componente){
+        if (!celdas.empty()) etiquetar(0, componente);
+    }
+
+    /**
+     * @brief Busca el nodo más cercano a `i` que está en otra componente.
+     *
+     * Solo se reemplaza la arista entregada si se encuentra una estrictamente mejor, comparando
+     * por peso y desempatando por el par (id menor, id mayor). Así la arista entregada sirve como
+     * cota inicial de la búsqueda y todas las consultas usan el mismo orden total.
+     *
+     * @param i Id del nodo de consulta.
+     * @param componente Componente de cada nodo, indexado por id.
+     * @param mejorPeso Peso de la mejor arista conocida (entrada y salida).
+     * @param mejorA Id menor de la mejor arista conocida, -1 si no hay (entrada y salida).
+     * @param mejorB Id mayor de la mejor arista conocida, -1 si no hay (entrada y salida).
+     */
+    void vecinoFuera(int i, const std::vector<int>& componente, double& mejorPeso, int& mejorA, int& mejorB) const {
+        if (!celdas.empty()) buscar(0, i, componente[i], componente, mejorPeso, mejorA, mejorB);
+    }
+};
+
+/**
+ * @class KDTreeDinamico
+ * @brief Árbol k-d que admite insertar y eliminar puntos sin reconstruirse en cada cambio.
+ *
+ * Guarda ids de un vector de nodos que puede crecer (`V[id].id` debe ser `id`). Al insertar, el punto
+ * baja por los cortes hasta una hoja y se agrandan las cajas del camino; una hoja con más de
+ * 2 `TAM_HOJA` puntos se divide por la mediana. Al eliminar, el punto sale de su hoja y las cajas no se
+ * achican, así que siguen siendo cotas válidas aunque más holgadas. Cuando los cambios desde la última
+ * construcción superan a los puntos guardados el árbol se reconstruye balanceado, lo que cuesta
+ * O(log N) amortizado por cambio.
+ *
+ * A diferencia de `KDTree`, la búsqueda es genérica: quien consulta decide qué celdas descartar y qué
+ * hacer con cada punto, así sirve tanto para vecinos por sectores como para vecinos fuera de una componente.
+ *
+ * @tparam D Número de coordenadas de los nodos.
+ */
+template <int D>
+class KDTreeDinamico {
+    typedef NodeD<D> Node;
+
+    struct Celda {
+        double min[D], max[D];         // caja que contiene a los puntos de la celda (puede ser más grande)
+        int eje;                       // coordenada del corte
+        double corte;                  // los puntos nuevos con coordenada menor van al hijo izquierdo
+        int izq, der;                  // hijos, -1 si es hoja
+        std::vector<int> puntos;       // ids de los puntos, solo en las hojas
+    };
+
+    const std::vector<Node>& V;  // Nodos indexados por id; puede crecer mientras se usa el árbol
+    std::vector<Celda> celdas;   // Celdas del árbol, la raíz es la 0
+    std::vector<int> hoja;       // Hoja que contiene a cada id, -1 si no está en el árbol
+    size_t cantidad = 0;         // Puntos guardados
+    size_t cambios = 0;          // Inserciones y eliminaciones desde la última construcción
+    static constexpr size_t TAM_HOJA = 8;
+
+    /**
+     * @brief Crea una hoja con los ids `ids[inicio, fin)` y la divide recursivamente por la mediana.
+     *
+     * @return Posición de la celda creada en `celdas`.
+     */
+    int construir(std::vector<int>& ids, size_t inicio, size_t fin){
+        Celda c;
+        for (int d=0; d<D; d++){
+            c.min[d] = std::numeric_limits<double>::infinity();
+            c.max[d] = -std::numeric_limits<double>::infinity();
+        }
+        for (size_t k=inicio; k<fin; k++){
+            const Node& p = V[ids[k]];
+            for (int d=0; d<D; d++){
+                c.min[d] = std::min(c.min[d], p[d]);
+                c.max[d] = std::max(c.max[d], p[d]);
+            }
+        }
+        c.eje = 0;
+        c.corte = 0;
+        c.izq = c.der = -1;
+
+        int pos = celdas.size();
+        if (fin - inicio <= TAM_HOJA){
+            c.puntos.assign(ids.begin() + inicio, ids.begin() + fin);
+            for (int id : c.puntos) hoja[id] = pos;
+            celdas.push_back(std::move(c));
+            return pos;
+        }
+
+        int eje = 0;
+        for (int d=1; d<D; d++){
+            if (c.max[d] - c.min[d] > c.max[eje] - c.min[eje]) eje = d;
+        }
+        size_t medio = (inicio + fin) / 2;
+        std::nth_element(ids.begin() + inicio, ids.begin() + medio, ids.begin() + fin,
+            [&](int a, int b){ return V[a][eje] < V[b][eje]; });
+        c.eje = eje;
+        c.corte = V[ids[medio]][eje];
+        celdas.push_back(std::move(c));
+
+        int izq = construir(ids, inicio, medio);
+        int der = construir(ids, medio, fin);
+        celdas[pos].izq = izq; // push_back puede invalidar referencias, se accede por posición
+        celdas[pos].der = der;
+        return pos;
+    }
+
+    /**
+     * @brief Divide una hoja demasiado grande en dos hojas nuevas, por la mediana de sus puntos.
+     *
+     * Las búsquedas solo usan las cajas, así que los puntos iguales a la mediana pueden quedar en cualquiera
+     * de los dos lados; con eso la división siempre reparte los puntos en mitades.
+     */
+    void dividir(int pos){
+        std::vector<int> ids = std::move(celdas[pos].puntos);
+        celdas[pos].puntos.clear();
+        int nuevo = construir(ids, 0, ids.size());
+        // `construir` dejó la celda dividida al final; se mueve a la posición de la hoja para no cambiar
+        // el enlace desde su padre
+        celdas[pos].eje = celdas[nuevo].eje;
+        celdas[pos].corte = celdas[nuevo].corte;
+        celdas[pos].izq = celdas[nuevo].izq;
+        celdas[pos].der = celdas[nuevo].der;
+        celdas[nuevo].izq = celdas[nuevo].der = -1; // queda como hoja vacía sin usar
+    }
+
+    /**
+     * @brief Cota inferior de la distancia al cuadrado entre un nodo y cualquier punto de una celda.
+     */
+    static double distanciaCaja(const Node& p, const Celda& c){
+        double suma = 0;
+        for (int d=0; d<D; d++){
+            double dx = 0;
+            if (p[d] < c.min[d]) dx = c.min[d] - p[d]; else if (p[d] > c.max[d]) dx = p[d] - c.max[d];
+            suma += dx*dx;
+        }
+        return suma;
+    }
+
+    template <class Descartar, class Visitar>
+    void buscar(int pos, const Node& p, Descartar& descartar, Visitar& visitar) const {
+        const Celda& c = celdas[pos];
+        if (descartar(c.min, c.max, distanciaCaja(p, c))) return;
+        if (c.izq == -1){
+            for (int id : c.puntos) visitar(id);
+            return;
+        }
+        // Se visita primero el hijo más cercano para acotar antes la búsqueda
+        int primero = c.izq, segundo = c.der;
+        if (distanciaCaja(p, celdas[segundo]) < distanciaCaja(p, celdas[primero])) std::swap(primero, segundo);
+        buscar(primero, p, descartar, visitar);
+        buscar(segundo, p, descartar, visitar);
+    }
+
+public:
+    /**
+     * @brief Crea el árbol sobre los ids entregados.
+     *
+     * @param Vertices Nodos indexados por id; se guarda una referencia al vector, que puede crecer después.
+     * @param ids Ids de los nodos que se guardan en el árbol.
+     */
+    KDTreeDinamico(const std::vector<Node>& Vertices, std::vector<int> ids = {}) : V(Vertices) {
+        reconstruir(ids);
+    }
+
+    /**
+     * @brief Descarta el árbol actual y lo construye balanceado sobre los ids entregados.
+     */
+    void reconstruir(std::vector<int> ids){
+        celdas.clear();
+        hoja.assign(V.size(), -1);
+        cantidad = ids.size();
+        cambios = 0;
+        if (!ids.empty()) construir(ids, 0, ids.size());
+    }
+
+    /**
+     * @brief Agrega el punto `id`, que no debe estar en el árbol.
+     */
+    void insertar(int id){
+        if (hoja.size() < V.size()) hoja.resize(V.size(), -1);
+        if (celdas.empty()){
+            reconstruir({id});
+            return;
+        }
+        const Node& p = V[id];
+        int pos = 0;
+        while (true){
+            Celda& c = celdas[pos];
+            for (int d=0; d<D; d++){
+                c.min[d] = std::min(c.min[d], p[d]);
+                c.max[d] = std::max(c.max[d], p[d]);
+            }
+            if (c.izq == -1) break;
+            pos = p[c.eje] < c.corte ? c.izq : c.der;
+        }
+        celdas[pos].puntos.push_back(id);
+        hoja[id] = pos;
+        cantidad++;
+        if (celdas[pos].puntos.size() > 2 * TAM_HOJA) dividir(pos);
+        if (++cambios > cantidad) reconstruir(ids());
+    }
+
+    /**
+     * @brief Quita el punto `id`, que debe estar en el árbol.
+     */
+    void eliminar(int id){
+        std::vector<int>& puntos = celdas[hoja[id]].puntos;
+        *std::find(puntos.begin(), puntos.end(), id) = puntos.back();
+        puntos.pop_back();
+        hoja[id] = -1;
+        cantidad--;
+        if (++cambios > cantidad) reconstruir(ids());
+    }
+
+    /**
+     * @brief Ids de todos los puntos guardados.
+     */
+    std::vector<int> ids() const {
+        std::vector<int> result;
+        result.reserve(cantidad);
+        for (const Celda& c : celdas) result.insert(result.end(), c.puntos.begin(), c.puntos.end());
+        return result;
+    }
+
+    /**
+     * @brief Recorre las celdas cercanas a `p`, primero las más cercanas.
+     *
+     * `descartar(min, max, distancia)` recibe la caja de una celda y la cota inferior de la distancia al
+     * cuadrado entre `p` y sus puntos, y devuelve true si la celda no puede tener puntos útiles. Se evalúa
+     * al llegar a cada celda, así que puede usar lo encontrado hasta ese momento. `visitar(id)` se llama
+     * con cada punto de las hojas no descartadas.
+     */
+    template <class Descartar, class Visitar>
+    void buscar(const Node& p, Descartar descartar, Visitar visitar) const {
+        if (!celdas.empty()) buscar(0, p, descartar, visitar);
+    }
+};
@@ -1,62 +1,129 @@
+#pragma once
 #include <algorithm>    // std::sort
+#include <cstring>      // std::memcpy
 #include <queue>
 #include "UnionFind.cpp"
+#include "ConcurrentUnionFind.cpp"
 #include "aux_f.cpp"
+#include "ordenamiento.cpp"
+#include "heap.cpp"
 
 /**
- * @brief Implementación del algoritmo de Kruskal sin optimización en la operación find y utilizando un arreglo de aristas ordenado.
+ * @brief Union-Find por tamaño sin compresión de caminos, usado por las variantes sin optimización en find.
+ */
+typedef UnionFindPolitica<SIN_COMPRESION> UnionFindSinCompresion;
+
+/**
+ * @brief Kruskal que ordena las aristas por bloques, solo hasta donde las necesita.
  *
- * Esta función construye un árbol de expansión mínima (MST) a partir de un grafo no dirigido.
- * Utiliza el algoritmo de Kruskal, ordenando previamente las aristas por peso en orden ascendente.
- * Las operaciones de unión y búsqueda se realizan mediante una estructura `UnionFind`, pero
- * la función `find_no_opt` no aplica compresión de caminos.
+ * En grafos completos de puntos la arista N-1 del MST aparece después de un prefijo pequeño del
+ * orden por peso, así que ordenar las M aristas es casi todo trabajo perdido. En cada etapa:
+ * 1. `std::nth_element` (introselect) deja las k aristas más livianas de las que quedan al principio del resto.
+ * 2. Solo esas k se ordenan y se recorren con el Union-Find.
+ * 3. Si el bosque todavía no cubre el grafo, k se ajusta con la tasa de aceptación observada en la etapa:
+ *    se estima cuántas aristas más se necesitan para las uniones que faltan, con un margen, y al menos se dobla.
+ * 4. Se descartan del resto las aristas cuyos extremos ya están en la misma componente, como en Filter-Kruskal.
+ *
+ * La primera etapa toma 4N aristas. Cada etapa recorre las aristas restantes dos veces, así que el
+ * costo es O(M) por etapa más O(k log k) por ordenar. Con puntos uniformes casi siempre bastan dos o tres
+ * etapas; con clusters las aristas entre clusters son las últimas del orden, pero el filtro deja solo esas.
+ * La columna `aristas_ordenadas` del benchmark registra cuántas aristas se ordenaron.
  *
+ * @tparam UF Tipo de Union-Find.
+ * @tparam D Número de coordenadas de los nodos; se deduce del grafo.
  * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
- * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo, ordenadas por peso.
  */
-std::vector<Edge> kruskal_array(Graph& G){
-    // Se ordenan las aristas por peso
-    std::vector<Edge> sorted_edges = G.E;
-    std::sort (sorted_edges.begin(), sorted_edges.end(), sortByWeight);
+template <class UF, int D>
+std::vector<EdgeD<D>> kruskal_array_parcial(GraphD<D>& G){
+    MedidorFase medidor;
+    VectorArena<EdgeD<D>> edges(G.E.begin(), G.E.end());
+    medidor.terminar(&TiemposFases::copia);
 
     int n = G.V.size();
-    std::vector<Edge> result;
+    size_t m = edges.size();
+    std::vector<EdgeD<D>> result;
+    if (n < 2) return result;
+    result.reserve(n - 1);
 
-    UnionFind uf(n);
+    UF uf(n);
+    size_t inicio = 0;
+    size_t bloque = 4 * (size_t)n;
 
-    for (auto& edge : sorted_edges){
-        int raiz_x = uf.find_no_opt(edge.n1->id);
-        int raiz_y = uf.find_no_opt(edge.n2->id);
-        if (raiz_x != raiz_y) { 
-            uf.union_(raiz_x, raiz_y);
-            result.push_back(edge);
-            if (result.size() == n - 1) break; // cuando se encuentran las n-1 aristas se termina
+    while (result.size() + 1 < n && inicio < m){
+        size_t fin = std::min(m, inicio + bloque);
+        if (fin < m) std::nth_element(edges.begin() + inicio, edges.begin() + fin, edges.begin() + m, sortByWeight);
+        std::sort(edges.begin() + inicio, edges.begin() + fin, sortByWeight);
+        contarOrdenadas(fin - inicio);
+        medidor.terminar(&TiemposFases::orden);
+
+        size_t antes = result.size();
+        for (size_t k=inicio; k<fin; k++){
+            CONTAR(aristasExaminadas, 1);
+            int raiz_x = uf.find(edges[k].n1->id);
+            int raiz_y = uf.find(edges[k].n2->id);
+
+            if (raiz_x != raiz_y) {
+                uf.union_(raiz_x, raiz_y);
+                result.push_back(edges[k]);
+                if (result.size() == n - 1) break; // cuando se encuentran n-1 aristas se termina
+            }
+        }
+        medidor.terminar(&TiemposFases::unionFind);
+
+        // La tasa de aceptación baja con el peso, así que la estimación se infla al doble
+        size_t aceptadas = result.size() - antes;
+        size_t faltan = n - 1 - result.size();
+        size_t estimado = aceptadas > 0 ? (size_t)(2.0 * faltan * (fin - inicio) / aceptadas) : 0;
+        bloque = std::max(2 * bloque, estimado);
+        inicio = fin;
+
+        // Se descartan las aristas restantes que ya quedaron dentro de una componente
+        if (faltan > 0 && inicio < m){
+            CONTAR(aristasExaminadas, m - inicio);
+            m = std::partition(edges.begin() + inicio, edges.begin() + m,
+                [&uf](const EdgeD<D>& e){ return uf.find(e.n1->id) != uf.find(e.n2->id); }) - edges.begin();
+            medidor.terminar(&TiemposFases::unionFind);
         }
     }
     return result;
 }
 
 /**
- * @brief Implementación del algoritmo de Kruskal con optimización en la operación find y utilizando un arreglo de aristas ordenado.
+ * @brief Implementación del algoritmo de Kruskal utilizando un arreglo de aristas ordenado, para cualquier Union-Find.
  *
  * Esta función construye un árbol de expansión mínima (MST) a partir de un grafo no dirigido.
  * Utiliza el algoritmo de Kruskal, ordenando previamente las aristas por peso en orden ascendente.
+ * El Union-Find se elige en tiempo de compilación, lo que permite comparar estrategias de `find`
+ * y de unión sin costo adicional.
  *
+ * @tparam UF Tipo de Union-Find, por ejemplo `UnionFindPolitica<COMPRESION_MITADES, UNION_RANGO>`.
+ * @tparam D Número de coordenadas de los nodos; se deduce del grafo.
  * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @param metodo Método con el que se ordenan las aristas (ver `MetodoOrden`).
+ * @param hilos Número de hilos usados por los métodos de ordenamiento paralelos.
  * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
  */
-std::vector<Edge> kruskal_array_Opti(Graph& G){
-    
+template <class UF, int D>
+std::vector<EdgeD<D>> kruskal_array_uf(GraphD<D>& G, MetodoOrden metodo, int hilos){
+    if (metodo == ORDEN_PARCIAL) return kruskal_array_parcial<UF>(G);
+
+    MedidorFase medidor;
     // Se ordenan las aristas por peso
-    std::vector<Edge> sorted_edges = G.E;
-    std::sort (sorted_edges.begin(), sorted_edges.end(), sortByWeight);
-    
+    VectorArena<EdgeD<D>> sorted_edges(G.E.begin(), G.E.end());
+    medidor.terminar(&TiemposFases::copia);
+    ordenarAristas(sorted_edges, metodo, hilos);
+    contarOrdenadas(sorted_edges.size());
+    medidor.terminar(&TiemposFases::orden);
+
     int n = G.V.size();
-    std::vector<Edge> result;
+    std::vector<EdgeD<D>> result;
+    if (n > 1) result.reserve(n - 1);
 
-    UnionFind uf(n);
+    UF uf(n);
 
     for (auto& edge : sorted_edges){
+        CONTAR(aristasExaminadas, 1);
         int raiz_x = uf.find(edge.n1->id);
         int raiz_y = uf.find(edge.n2->id);
 
@@ -64,13 +131,64 @@ std::vector<Edge> kruskal_array_Opti(Graph& G){
             uf.union_(raiz_x, raiz_y);
             result.push_back(edge);
             if (result.size() == n - 1) break; // cuando se encuentran n-1 aristas se termina
-            
         }
     }
+    medidor.terminar(&TiemposFases::unionFind);
 
     return result;
 }
 
+/**
+ * @brief Implementación del algoritmo de Kruskal sin optimización en la operación find y utilizando un arreglo de aristas ordenado.
+ *
+ * Esta función construye un árbol de expansión mínima (MST) a partir de un grafo no dirigido.
+ * Utiliza el algoritmo de Kruskal, ordenando previamente las aristas por peso en orden ascendente.
+ * Las operaciones de unión y búsqueda se realizan mediante un Union-Find que
+ * no aplica compresión de caminos.
+ *
+ * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @param metodo Método con el que se ordenan las aristas (ver `MetodoOrden`).
+ * @param hilos Número de hilos usados por los métodos de ordenamiento paralelos.
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+template <int D>
+std::vector<EdgeD<D>> kruskal_array(GraphD<D>& G, MetodoOrden metodo, int hilos){
+    return kruskal_array_uf<UnionFindSinCompresion>(G, metodo, hilos);
+}
+
+/**
+ * @brief Kruskal sin optimización en find con un arreglo ordenado con `std::sort`.
+ */
+template <int D>
+std::vector<EdgeD<D>> kruskal_array(GraphD<D>& G){
+    return kruskal_array(G, ORDEN_STD, 1);
+}
+
+/**
+ * @brief Implementación del algoritmo de Kruskal con optimización en la operación find y utilizando un arreglo de aristas ordenado.
+ *
+ * Esta función construye un árbol de expansión mínima (MST) a partir de un grafo no dirigido.
+ * Utiliza el algoritmo de Kruskal, ordenando previamente las aristas por peso en orden ascendente.
+ * El Union-Find aplica compresión completa de caminos.
+ *
+ * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @param metodo Método con el que se ordenan las aristas (ver `MetodoOrden`).
+ * @param hilos Número de hilos usados por los métodos de ordenamiento paralelos.
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+template <int D>
+std::vector<EdgeD<D>> kruskal_array_Opti(GraphD<D>& G, MetodoOrden metodo, int hilos){
+    return kruskal_array_uf<UnionFind>(G, metodo, hilos);
+}
+
+/**
+ * @brief Kruskal con optimización en find con un arreglo ordenado con `std::sort`.
+ */
+template <int D>
+std::vector<EdgeD<D>> kruskal_array_Opti(GraphD<D>& G){
+    return kruskal_array_Opti(G, ORDEN_STD, 1);
+}
+
 
 
 
@@ -78,42 +196,116 @@ std::vector<Edge> kruskal_array_Opti(Graph& G){
 
 
 /**
- * @brief Implementación del algoritmo de Kruskal sin optimización en la operación find y utilizando un heap.
+ * @brief Kruskal con un heap D-ario implícito sobre claves compactas de las aristas.
  *
- * Esta función construye un árbol de expansión mínima (MST) a partir de un grafo no dirigido.
- * A diferencia de la versión basada en arreglo ordenado, aquí se utiliza un heap (`priority_queue`) 
- * para obtener iterativamente la arista de menor peso..
+ * En vez de copiar `G.E` a una `std::priority_queue`, se arma un arreglo de claves (peso, índice)
+ * y se convierte en heap en su lugar. Las aristas se leen de `G.E` solo al sacarlas del heap.
+ *
+ * @tparam Hijos Número de hijos de cada nodo del heap.
+ * @tparam UF Tipo de Union-Find.
+ * @tparam D Número de coordenadas de los nodos; se deduce del grafo.
+ * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+template <int Hijos, class UF, int D>
+std::vector<EdgeD<D>> kruskal_heap_dario(GraphD<D>& G){
+    MedidorFase medidor;
+    VectorArena<ClaveArista> claves(G.E.size());
+    for (size_t k=0; k<G.E.size(); k++) claves[k] = {G.E[k].peso, k};
+    medidor.terminar(&TiemposFases::copia);
+    HeapDario<Hijos> heap(std::move(claves));
+    medidor.terminar(&TiemposFases::orden);
+
+    int n = G.V.size();
+    std::vector<EdgeD<D>> result;
+    if (n > 1) result.reserve(n - 1);
+
+    UF uf(n);
+
+    while(result.size() + 1 < n){
+        const EdgeD<D>& edge = G.E[heap.top().indice];
+        heap.pop();
+        CONTAR(aristasExaminadas, 1);
+
+        int raiz_x = uf.find(edge.n1->id);
+        int raiz_y = uf.find(edge.n2->id);
+
+        if (raiz_x != raiz_y) {
+            uf.union_(raiz_x, raiz_y);
+            result.push_back(edge);
+        }
+    }
+    medidor.terminar(&TiemposFases::unionFind);
+    return result;
+}
+
+/**
+ * @brief Implementación del algoritmo de Kruskal utilizando un heap, para cualquier Union-Find.
  *
- * Las búsquedas de raíces (`find_no_opt`) no están optimizadas, es decir, no utilizan compresión de caminos.
+ * Esta función construye un árbol de expansión mínima (MST) a partir de un grafo no dirigido.
+ * A diferencia de la versión basada en arreglo ordenado, aquí se utiliza un heap
+ * para obtener iterativamente la arista de menor peso, sin ordenar completamente el conjunto de aristas.
  *
+ * @tparam UF Tipo de Union-Find.
+ * @tparam D Número de coordenadas de los nodos; se deduce del grafo.
  * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @param metodo Heap que se utiliza (ver `MetodoHeap`).
  * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
  */
-std::vector<Edge> kruskal_heap(Graph& G){
+template <class UF, int D>
+std::vector<EdgeD<D>> kruskal_heap_uf(GraphD<D>& G, MetodoHeap metodo){
+    if (metodo == HEAP_4ARIO) return kruskal_heap_dario<4, UF>(G);
+    if (metodo == HEAP_8ARIO) return kruskal_heap_dario<8, UF>(G);
+
+    MedidorFase medidor;
     // Se ordenan las aristas por peso
-    std::vector<Edge> sorted_edges = G.E;
-    std::priority_queue heap(sorted_edges.begin(), sorted_edges.end(), sortByWeightHeap);
+    VectorArena<EdgeD<D>> sorted_edges(G.E.begin(), G.E.end());
+    medidor.terminar(&TiemposFases::copia);
+    // El heap toma posesión de la copia y la ordena en su lugar, sin una segunda copia
+    std::priority_queue<EdgeD<D>, VectorArena<EdgeD<D>>, ComparadorPesoDescendente> heap(sortByWeightHeap, std::move(sorted_edges));
+    medidor.terminar(&TiemposFases::orden);
 
     int n = G.V.size();
-    std::vector<Edge> result;
+    std::vector<EdgeD<D>> result;
+    if (n > 1) result.reserve(n - 1);
 
-    UnionFind uf(n);
+    UF uf(n);
 
-    while(result.size() < n-1 ){
-        Edge edge = heap.top();
+    while(result.size() + 1 < n){
+        EdgeD<D> edge = heap.top();
         heap.pop();
+        CONTAR(aristasExaminadas, 1);
 
-        int raiz_x = uf.find_no_opt(edge.n1->id);
-        int raiz_y = uf.find_no_opt(edge.n2->id);
+        int raiz_x = uf.find(edge.n1->id);
+        int raiz_y = uf.find(edge.n2->id);
 
         if (raiz_x != raiz_y) { 
             uf.union_(raiz_x, raiz_y);
             result.push_back(edge);
         }
     }
+    medidor.terminar(&TiemposFases::unionFind);
     return result;
 }
 
+/**
+ * @brief Implementación del algoritmo de Kruskal sin optimización en la operación find y utilizando un heap.
+ *
+ * Esta función construye un árbol de expansión mínima (MST) a partir de un grafo no dirigido.
+ * A diferencia de la versión basada en arreglo ordenado, aquí se utiliza un heap (`priority_queue`) 
+ * para obtener iterativamente la arista de menor peso..
+ *
+ * Las búsquedas de raíces no están optimizadas, es decir, no utilizan compresión de caminos.
+ *
+ * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @param metodo Heap que se utiliza (ver `MetodoHeap`).
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+template <int D>
+std::vector<EdgeD<D>> kruskal_heap(GraphD<D>& G, MetodoHeap metodo){
+    return kruskal_heap_uf<UnionFindSinCompresion>(G, metodo);
+}
+
 /**
  * @brief Implementación del algoritmo de Kruskal con optimización en la operación find y utilizando un heap.
  *
@@ -122,30 +314,314 @@ std::vector<Edge> kruskal_heap(Graph& G){
  * sin necesidad de ordenar completamente el conjunto de aristas. Además, emplea una versión optimizada de la operación `find`.
  *
  * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @param metodo Heap que se utiliza (ver `MetodoHeap`).
  * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
  */
-std::vector<Edge> kruskal_heap_Opti(Graph& G){
-    // Se ordenan las aristas por peso
-    std::vector<Edge> sorted_edges = G.E;
-    std::priority_queue heap(sorted_edges.begin(), sorted_edges.end(), sortByWeightHeap);
-    
+template <int D>
+std::vector<EdgeD<D>> kruskal_heap_Opti(GraphD<D>& G, MetodoHeap metodo){
+    return kruskal_heap_uf<UnionFind>(G, metodo);
+}
+
+/**
+ * @brief Kruskal sin optimización en find con `std::priority_queue`.
+ */
+template <int D>
+std::vector<EdgeD<D>> kruskal_heap(GraphD<D>& G){
+    return kruskal_heap(G, HEAP_STD);
+}
+
+/**
+ * @brief Kruskal con optimización en find con `std::priority_queue`.
+ */
+template <int D>
+std::vector<EdgeD<D>> kruskal_heap_Opti(GraphD<D>& G){
+    return kruskal_heap_Opti(G, HEAP_STD);
+}
+
+
+// ------------------------------------------------------------------------------------------------
+
+
+/**
+ * @brief Descarta las aristas de `edges[inicio, fin)` cuyos extremos ya están en la misma componente.
+ *
+ * @param edges Aristas del grafo; las que se mantienen quedan al principio del rango.
+ * @param inicio Primer índice del rango.
+ * @param fin Índice siguiente al último del rango.
+ * @param uf Union-Find con las componentes encontradas hasta ahora.
+ * @param hilos No se usa: `UnionFindPolitica` solo puede usarse desde un hilo.
+ * @return Índice siguiente a la última arista que se mantiene.
+ */
+template <Compresion C, CriterioUnion U, bool ArregloUnico>
+size_t filtrarPesadas(VectorArena<Edge>& edges, size_t inicio, size_t fin,
+                      UnionFindPolitica<C, U, ArregloUnico>& uf, int /*hilos*/){
+    CONTAR(aristasExaminadas, fin - inicio);
+    return std::partition(edges.begin() + inicio, edges.begin() + fin,
+        [&uf](const Edge& e){ return uf.find(e.n1->id) != uf.find(e.n2->id); }) - edges.begin();
+}
+
+/**
+ * @brief Descarta en paralelo las aristas de `edges[inicio, fin)` cuyos extremos ya están en la misma componente.
+ *
+ * Cada hilo filtra un bloque del rango consultando el Union-Find concurrente, y luego
+ * los bloques filtrados se juntan al principio del rango.
+ *
+ * @param edges Aristas del grafo; las que se mantienen quedan al principio del rango.
+ * @param inicio Primer índice del rango.
+ * @param fin Índice siguiente al último del rango.
+ * @param uf Union-Find concurrente con las componentes encontradas hasta ahora.
+ * @param hilos Número de hilos a usar.
+ * @return Índice siguiente a la última arista que se mantiene.
+ */
+size_t filtrarPesadas(VectorArena<Edge>& edges, size_t inicio, size_t fin, ConcurrentUnionFind& uf, int hilos){
+    const size_t MINIMO_POR_HILO = 1 << 14; // con menos aristas no vale la pena crear hilos
+    size_t m = fin - inicio;
+    CONTAR(aristasExaminadas, m);
+    if (hilos > (int)(m / MINIMO_POR_HILO)) hilos = m / MINIMO_POR_HILO;
+    if (hilos < 1) hilos = 1;
+
+    std::vector<size_t> limites, utiles(hilos);
+    for (int t=0; t<=hilos; t++) limites.push_back(inicio + m * t / hilos);
+
+    std::vector<std::thread> trabajadores;
+    for (int t=0; t<hilos; t++){
+        trabajadores.push_back(std::thread([&, t](){
+            utiles[t] = std::partition(edges.begin() + limites[t], edges.begin() + limites[t+1],
+                [&uf](const Edge& e){ return !uf.mismoConjunto(e.n1->id, e.n2->id); }) - edges.begin();
+        }));
+    }
+    for (std::thread& t : trabajadores) t.join();
+
+    // Se juntan los bloques filtrados
+    size_t destino = utiles[0];
+    for (int t=1; t<hilos; t++){
+        destino = std::move(edges.begin() + limites[t], edges.begin() + utiles[t], edges.begin() + destino) - edges.begin();
+    }
+    return destino;
+}
+
+/**
+ * @brief Recorre `edges[inicio, fin)`, ya en orden de peso, y agrega al MST las aristas que unen componentes distintas.
+ */
+template <class UF>
+void unirRango(VectorArena<Edge>& edges, size_t inicio, size_t fin, int n, UF& uf, std::vector<Edge>& result){
+    for (size_t k=inicio; k<fin; k++){
+        CONTAR(aristasExaminadas, 1);
+        int raiz_x = uf.find(edges[k].n1->id);
+        int raiz_y = uf.find(edges[k].n2->id);
+
+        if (raiz_x != raiz_y) {
+            uf.union_(raiz_x, raiz_y);
+            result.push_back(edges[k]);
+            if (result.size() == n - 1) return; // cuando se encuentran n-1 aristas se termina
+        }
+    }
+}
+
+/**
+ * @brief Paso recursivo de Filter-Kruskal sobre las aristas `edges[inicio, fin)`.
+ *
+ * Si el rango es pequeño se ordena y se procesa como en Kruskal. Si no, se particiona en tres alrededor
+ * de un pivote elegido al azar: las aristas más livianas, las que pesan lo mismo que el pivote y las más
+ * pesadas. Primero se procesan las livianas, luego las iguales (que no necesitan orden entre ellas) y
+ * por último, de las pesadas, se descartan las que unen nodos que ya están en la misma componente antes
+ * de seguir con ellas. Como el pivote nunca queda en las partes que se procesan recursivamente, con
+ * muchos pesos repetidos el rango siempre se achica y nunca hay que ordenarlo entero.
+ *
+ * @tparam UF Tipo de Union-Find (`UnionFindPolitica` o `ConcurrentUnionFind`).
+ * @param edges Aristas del grafo; el rango se reordena en su lugar.
+ * @param inicio Primer índice del rango.
+ * @param fin Índice siguiente al último del rango.
+ * @param n Número de nodos del grafo.
+ * @param uf Union-Find con las componentes encontradas hasta ahora.
+ * @param result Aristas del MST encontradas hasta ahora.
+ * @param gen Generador usado para elegir los pivotes.
+ * @param hilos Número de hilos usados para filtrar las aristas pesadas.
+ */
+template <class UF>
+void filter_kruskal(VectorArena<Edge>& edges, size_t inicio, size_t fin, int n,
+                    UF& uf, std::vector<Edge>& result, std::mt19937& gen, int hilos){
+    const size_t UMBRAL = 1024; // bajo este tamaño se ordena directamente
+    if (result.size() == n - 1) return;
+
+    if (fin - inicio <= UMBRAL){
+        std::sort(edges.begin() + inicio, edges.begin() + fin, sortByWeight);
+        contarOrdenadas(fin - inicio);
+        unirRango(edges, inicio, fin, n, uf, result);
+        return;
+    }
+
+    std::uniform_int_distribution<size_t> dist(inicio, fin - 1);
+    double pivote = edges[dist(gen)].peso;
+    size_t menores = std::partition(edges.begin() + inicio, edges.begin() + fin,
+        [pivote](const Edge& e){ return e.peso < pivote; }) - edges.begin();
+    size_t iguales = std::partition(edges.begin() + menores, edges.begin() + fin,
+        [pivote](const Edge& e){ return e.peso == pivote; }) - edges.begin();
+
+    filter_kruskal(edges, inicio, menores, n, uf, result, gen, hilos);
+    if (result.size() == n - 1) return;
+    unirRango(edges, menores, iguales, n, uf, result);
+    if (result.size() == n - 1) return;
+
+    // Se descartan las aristas pesadas que ya no pueden pertenecer al MST
+    size_t utiles = filtrarPesadas(edges, iguales, fin, uf, hilos);
+    filter_kruskal(edges, iguales, utiles, n, uf, result, gen, hilos);
+}
+
+/**
+ * @brief Implementación del algoritmo Filter-Kruskal con optimización en la operación find.
+ *
+ * Esta función construye un árbol de expansión mínima (MST) a partir de un grafo no dirigido.
+ * A diferencia de `kruskal_array_Opti`, no ordena todas las aristas: las particiona recursivamente
+ * como quicksort, procesa primero la parte liviana y filtra la parte pesada con el Union-Find.
+ * En grafos completos con puntos aleatorios el MST se completa con una fracción pequeña de
+ * las aristas, así que la mayor parte nunca se ordena.
+ *
+ * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+std::vector<Edge> kruskal_filter(Graph& G){
+    MedidorFase medidor;
+    VectorArena<Edge> edges(G.E.begin(), G.E.end());
+    medidor.terminar(&TiemposFases::copia);
+
     int n = G.V.size();
     std::vector<Edge> result;
+    if (n < 2) return result;
+    result.reserve(n - 1);
 
     UnionFind uf(n);
+    std::mt19937 gen(n); // semilla fija para que las ejecuciones sean reproducibles
 
-    while(result.size() < n-1 ){
-        Edge edge = heap.top();
-        heap.pop();
+    filter_kruskal(edges, 0, edges.size(), n, uf, result, gen, 1);
+    return result;
+}
 
-        int raiz_x = uf.find(edge.n1->id);
-        int raiz_y = uf.find(edge.n2->id);
+/**
+ * @brief Implementación de Filter-Kruskal que filtra las aristas pesadas en paralelo.
+ *
+ * Es el mismo algoritmo que `kruskal_filter`, pero usa un `ConcurrentUnionFind` para que varios
+ * hilos puedan consultar las componentes a la vez al descartar aristas pesadas, que es la etapa
+ * que recorre la mayor parte de las aristas.
+ *
+ * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @param hilos Número de hilos usados para filtrar.
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+std::vector<Edge> kruskal_filter_paralelo(Graph& G, int hilos){
+    MedidorFase medidor;
+    VectorArena<Edge> edges(G.E.begin(), G.E.end());
+    medidor.terminar(&TiemposFases::copia);
 
-        if (raiz_x != raiz_y) {
-            uf.union_(raiz_x, raiz_y); 
-            result.push_back(edge);
+    int n = G.V.size();
+    std::vector<Edge> result;
+    if (n < 2) return result;
+    result.reserve(n - 1);
+
+    ConcurrentUnionFind uf(n);
+    std::mt19937 gen(n); // semilla fija para que las ejecuciones sean reproducibles
+
+    filter_kruskal(edges, 0, edges.size(), n, uf, result, gen, hilos);
+    return result;
+}
+
+
+// ------------------------------------------------------------------------------------------------
+
+
+/**
+ * @brief Cubeta de un peso para `kruskal_cubetas_uf`: los 16 bits más significativos de su representación IEEE-754.
+ *
+ * Como los pesos son no negativos, el orden de las cubetas es el de los pesos. Cada cubeta cubre
+ * un rango de pesos de ancho relativo 1/16 dentro de una potencia de 2, así que las cubetas se adaptan
+ * a la escala de los pesos sin conocer su máximo.
+ */
+inline uint32_t cubetaArista(double peso){
+    uint64_t bits;
+    std::memcpy(&bits, &peso, sizeof(bits));
+    return bits >> 48;
+}
+
+/**
+ * @brief Kruskal con una cola de cubetas monótona sobre los pesos, sin ordenar todas las aristas.
+ *
+ * 1. Se cuenta cuántas aristas caen en cada una de las 2^16 cubetas (ver `cubetaArista`).
+ * 2. Las cubetas se procesan en orden creciente, por etapas: en cada etapa se copian a un buffer
+ *    solo las aristas de las cubetas siguientes, hasta juntar al menos 4N aristas en la primera etapa
+ *    y el doble en cada etapa posterior.
+ * 3. Cada cubeta se ordena con `std::sort` recién cuando Kruskal llega a ella, y se termina al
+ *    encontrar N-1 aristas.
+ *
+ * En grafos completos de puntos el MST se completa con las aristas más livianas, así que casi
+ * ninguna arista se copia ni se ordena: el costo lo dominan una o dos lecturas de `G.E`.
+ * Si los pesos se concentran en pocas cubetas el peor caso es el de ordenar todo con `std::sort`.
+ *
+ * @tparam UF Tipo de Union-Find.
+ * @param G Grafo de entrada, que contiene un conjunto de nodos (`G.V`) y aristas (`G.E`).
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+template <class UF>
+std::vector<Edge> kruskal_cubetas_uf(Graph& G){
+    const size_t CUBETAS = 1 << 16;
+    MedidorFase medidor;
+    int n = G.V.size();
+    std::vector<Edge> result;
+    if (n < 2) return result;
+    result.reserve(n - 1);
+
+    // conteo[c] = aristas en las cubetas menores que c
+    VectorArena<size_t> conteo(CUBETAS + 1);
+    for (const Edge& e : G.E) conteo[cubetaArista(e.peso) + 1]++;
+    for (size_t c=1; c<=CUBETAS; c++) conteo[c] += conteo[c-1];
+    medidor.terminar(&TiemposFases::copia);
+
+    UF uf(n);
+    VectorArena<Edge> etapa;
+    VectorArena<size_t> posicion(CUBETAS);
+    size_t meta = 4 * (size_t)n;
+
+    for (size_t desde=0; desde<CUBETAS && result.size() + 1 < n; meta *= 2){
+        size_t hasta = desde + 1;
+        while (hasta < CUBETAS && conteo[hasta] - conteo[desde] < meta) hasta++;
+
+        // Se copian las aristas de las cubetas [desde, hasta), agrupadas por cubeta
+        size_t base = conteo[desde];
+        etapa.resize(conteo[hasta] - base);
+        for (size_t c=desde; c<hasta; c++) posicion[c] = conteo[c] - base;
+        for (const Edge& e : G.E){
+            uint32_t c = cubetaArista(e.peso);
+            if (c >= desde && c < hasta) etapa[posicion[c]++] = e;
         }
-    }
+        medidor.terminar(&TiemposFases::copia);
+
+        for (size_t c=desde; c<hasta && result.size() + 1 < n; c++){
+            auto inicio = etapa.begin() + (conteo[c] - base);
+            auto fin = etapa.begin() + (conteo[c+1] - base);
+            std::sort(inicio, fin, sortByWeight);
+            contarOrdenadas(fin - inicio);
+            medidor.terminar(&TiemposFases::orden);
+
+            for (auto it=inicio; it!=fin; ++it){
+                CONTAR(aristasExaminadas, 1);
+                int raiz_x = uf.find(it->n1->id);
+                int raiz_y = uf.find(it->n2->id);
 
+                if (raiz_x != raiz_y) {
+                    uf.union_(raiz_x, raiz_y);
+                    result.push_back(*it);
+                    if (result.size() == n - 1) break; // cuando se encuentran n-1 aristas se termina
+                }
+            }
+            medidor.terminar(&TiemposFases::unionFind);
+        }
+        desde = hasta;
+    }
     return result;
 }
+
+/**
+ * @brief Kruskal con cola de cubetas y Union-Find con compresión de caminos.
+ */
+std::vector<Edge> kruskal_cubetas(Graph& G){
+    return kruskal_cubetas_uf<UnionFind>(G);
+}
@@ -0,0 +1,240 @@
+#pragma once
+#include <algorithm>    // std::sort
+#include <chrono>
+#include <cmath>        // std::log2
+#include <deque>
+#include <mutex>
+#include <thread>
+#include "kruskal.cpp"
+#include "geometrico.cpp"
+
+/**
+ * @brief Algoritmos con los que se puede resolver un trabajo de un lote.
+ */
+enum MotorMST {
+    MOTOR_AUTOMATICO,  // se elige con `motorPara` según el tamaño del trabajo
+    MOTOR_ARRAY,       // `kruskal_array_Opti`
+    MOTOR_HEAP,        // `kruskal_heap_Opti`
+    MOTOR_FILTER,      // `kruskal_filter`
+    MOTOR_CUBETAS,     // `kruskal_cubetas`
+    MOTOR_GEOMETRICO   // `kruskal_geometrico`, no usa las aristas del grafo
+};
+
+/**
+ * @brief Nombre del motor, para mostrarlo en los resultados.
+ */
+const char* nombreMotor(MotorMST motor){
+    switch (motor){
+        case MOTOR_ARRAY: return "array";
+        case MOTOR_HEAP: return "heap";
+        case MOTOR_FILTER: return "filter";
+        case MOTOR_CUBETAS: return "cubetas";
+        case MOTOR_GEOMETRICO: return "geometrico";
+        default: return "automatico";
+    }
+}
+
+/**
+ * @brief Motor más rápido para un trabajo de N puntos, medido con puntos uniformes.
+ *
+ * Si solo se tienen los puntos, construir las N(N-1)/2 aristas ya cuesta más que `kruskal_geometrico`
+ * desde N = 16, así que siempre se usa ese. Si el grafo ya tiene sus aristas, el heap gana con
+ * grafos muy pequeños, Filter-Kruskal hasta unos cientos de nodos y las cubetas (cuyo costo fijo es
+ * contar 2^16 cubetas) hasta unos miles; sobre eso vuelve a ganar el geométrico.
+ *
+ * @param N Número de puntos del trabajo.
+ * @param conAristas true si el trabajo trae un `Graph` con sus aristas.
+ */
+MotorMST motorPara(size_t N, bool conAristas){
+    if (!conAristas) return MOTOR_GEOMETRICO;
+    if (N <= 32) return MOTOR_HEAP;
+    if (N <= 192) return MOTOR_FILTER;
+    if (N <= 1536) return MOTOR_CUBETAS;
+    return MOTOR_GEOMETRICO;
+}
+
+/**
+ * @brief Resultado de un trabajo de un lote.
+ */
+struct ResultadoMST {
+    std::vector<Edge> mst;  // apunta a los nodos del trabajo (ver `LoteMST::agregar`)
+    MotorMST motor = MOTOR_AUTOMATICO;  // motor con el que se resolvió
+    double espera = 0;      // segundos desde el inicio de `resolver` hasta que el trabajo empezó
+    double tiempo = 0;      // segundos que tomó resolverlo
+    int hilo = -1;          // hilo que lo resolvió
+    TiemposFases fases;     // tiempo de cada etapa del motor
+};
+
+/**
+ * @brief Ejecuta las tareas [0, costos.size()) con `hilos` hilos que se roban trabajo entre sí.
+ *
+ * Cada hilo tiene su propia cola. Las tareas se reparten entre las colas en orden de costo
+ * decreciente; cada hilo toma las tareas del frente de su cola (las más caras primero) y, cuando
+ * se vacía, roba del final de la cola de otro hilo (las más baratas). Así un hilo al que le tocaron
+ * tareas grandes no deja a los demás esperando. Cada cola tiene su mutex, que solo se disputa al robar.
+ *
+ * @param hilos Número de hilos; si es menor que 1 se usa 1.
+ * @param costos Costo estimado de cada tarea; solo se usa su orden.
+ * @param f Función `f(tarea, hilo)` que ejecuta una tarea.
+ */
+template <class F>
+void ejecutarConRobo(int hilos, const std::vector<double>& costos, F f){
+    struct Cola {
+        std::mutex m;
+        std::deque<size_t> tareas;
+    };
+    size_t total = costos.size();
+    if (hilos < 1) hilos = 1;
+    if (hilos > (int)total) hilos = total;
+    if (hilos == 0) return;
+
+    std::vector<size_t> orden(total);
+    for (size_t k=0; k<total; k++) orden[k] = k;
+    std::stable_sort(orden.begin(), orden.end(), [&costos](size_t a, size_t b){ return costos[a] > costos[b]; });
+    std::deque<Cola> colas(hilos);
+    for (size_t k=0; k<total; k++) colas[k % hilos].tareas.push_back(orden[k]);
+
+    // No se agregan tareas mientras se ejecutan, así que un hilo que no encuentra ninguna termina
+    auto trabajador = [&](int t){
+        while (true){
+            size_t tarea = total;
+            {
+                std::lock_guard<std::mutex> lock(colas[t].m);
+                if (!colas[t].tareas.empty()){
+                    tarea = colas[t].tareas.front();
+                    colas[t].tareas.pop_front();
+                }
+            }
+            // Se roba empezando por el hilo siguiente, para no cargar a todos contra el mismo
+            for (int k=1; k<hilos && tarea == total; k++){
+                Cola& otra = colas[(t + k) % hilos];
+                std::lock_guard<std::mutex> lock(otra.m);
+                if (!otra.tareas.empty()){
+                    tarea = otra.tareas.back();
+                    otra.tareas.pop_back();
+                }
+            }
+            if (tarea == total) break;
+            f(tarea, t);
+        }
+    };
+
+    std::vector<std::thread> trabajadores;
+    for (int t=1; t<hilos; t++) trabajadores.push_back(std::thread(trabajador, t));
+    trabajador(0);
+    for (std::thread& t : trabajadores) t.join();
+}
+
+/**
+ * @class LoteMST
+ * @brief Resuelve muchos MST independientes repartiéndolos entre varios hilos.
+ *
+ * Cada trabajo se resuelve en un solo hilo con un motor secuencial, elegido por `motorPara` si no
+ * se indica; el paralelismo está entre trabajos, así que el rendimiento escala con los núcleos aunque
+ * cada trabajo sea pequeño. Los trabajos se reparten con `ejecutarConRobo`, con un costo estimado de
+ * N^2 si el motor recorre las aristas y N log N si es el geométrico.
+ *
+ * Un trabajo puede ser un conjunto de puntos, que el lote guarda, o un `Graph` con sus aristas, que
+ * debe seguir existiendo hasta que termine `resolver`. Las aristas de cada resultado apuntan a los
+ * nodos del lote o del grafo, así que son válidas mientras estos existan.
+ *
+ * ### Ejemplo de uso:
+ * @code
+ * LoteMST lote;
+ * for (int k=0; k<100; k++) lote.agregar(generarPuntos(1000, k));
+ * std::vector<ResultadoMST> resultados = lote.resolver(8);
+ * @endcode
+ */
+class LoteMST {
+    struct Trabajo {
+        std::vector<Node> puntos;   // vacío si el trabajo es un grafo
+        Graph* grafo = nullptr;
+        MotorMST motor;
+    };
+    std::deque<Trabajo> trabajos;   // un deque no mueve los trabajos al agregar otros
+
+public:
+    /**
+     * @brief Agrega un trabajo con un conjunto de puntos.
+     *
+     * @param puntos Puntos del trabajo; sus ids se reasignan a su posición.
+     * @param motor Motor con el que se resuelve.
+     * @return Índice del trabajo, que es su posición en el resultado de `resolver`.
+     */
+    size_t agregar(std::vector<Node> puntos, MotorMST motor = MOTOR_AUTOMATICO){
+        for (size_t i=0; i<puntos.size(); i++) puntos[i].id = i;
+        if (motor == MOTOR_AUTOMATICO) motor = motorPara(puntos.size(), false);
+        trabajos.push_back({std::move(puntos), nullptr, motor});
+        return trabajos.size() - 1;
+    }
+
+    /**
+     * @brief Agrega un trabajo con un grafo que ya tiene sus aristas.
+     *
+     * @param G Grafo del trabajo; no se copia.
+     * @param motor Motor con el que se resuelve.
+     * @return Índice del trabajo, que es su posición en el resultado de `resolver`.
+     */
+    size_t agregar(Graph& G, MotorMST motor = MOTOR_AUTOMATICO){
+        if (motor == MOTOR_AUTOMATICO) motor = motorPara(G.V.size(), true);
+        trabajos.push_back({{}, &G, motor});
+        return trabajos.size() - 1;
+    }
+
+    /**
+     * @brief Número de trabajos agregados.
+     */
+    size_t size() const { return trabajos.size(); }
+
+    /**
+     * @brief Resuelve todos los trabajos agregados.
+     *
+     * @param hilos Número de hilos a usar.
+     * @return Un resultado por trabajo, en el orden en que se agregaron.
+     */
+    std::vector<ResultadoMST> resolver(int hilos){
+        std::vector<ResultadoMST> resultados(trabajos.size());
+        std::vector<double> costos(trabajos.size());
+        for (size_t k=0; k<trabajos.size(); k++){
+            double n = trabajos[k].grafo ? trabajos[k].grafo->V.size() : trabajos[k].puntos.size();
+            costos[k] = trabajos[k].motor == MOTOR_GEOMETRICO ? n * std::log2(n + 1) : n * n;
+        }
+
+        auto inicio = std::chrono::steady_clock::now();
+        ejecutarConRobo(hilos, costos, [&](size_t k, int hilo){
+            ResultadoMST& r = resultados[k];
+            r.motor = trabajos[k].motor;
+            r.hilo = hilo;
+            fasesActivas = &r.fases; // es local al hilo
+            auto comienzo = std::chrono::steady_clock::now();
+            r.mst = resolverTrabajo(trabajos[k]);
+            auto fin = std::chrono::steady_clock::now();
+            fasesActivas = nullptr;
+            r.espera = std::chrono::duration<double>(comienzo - inicio).count();
+            r.tiempo = std::chrono::duration<double>(fin - comienzo).count();
+        });
+        return resultados;
+    }
+
+private:
+    static std::vector<Edge> resolverGrafo(Graph& G, MotorMST motor){
+        switch (motor){
+            case MOTOR_ARRAY: return kruskal_array_Opti(G);
+            case MOTOR_HEAP: return kruskal_heap_Opti(G);
+            case MOTOR_FILTER: return kruskal_filter(G);
+            case MOTOR_GEOMETRICO: return kruskal_geometrico(G);
+            default: return kruskal_cubetas(G);
+        }
+    }
+
+    static std::vector<Edge> resolverTrabajo(Trabajo& t){
+        if (t.grafo) return resolverGrafo(*t.grafo, t.motor);
+        if (t.motor == MOTOR_GEOMETRICO) return kruskal_geometrico(t.puntos);
+
+        // El grafo copia los puntos: las aristas del MST se vuelven a apuntar a los del trabajo
+        Graph G(t.puntos, 1);
+        std::vector<Edge> mst = resolverGrafo(G, t.motor);
+        for (Edge& e : mst) e = Edge(&t.puntos[e.n1->id], &t.puntos[e.n2->id]);
+        return mst;
+    }
+};
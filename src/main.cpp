@@ -1,128 +1,315 @@
-#include <fstream>
-#include "kruskal.cpp"
-#include <chrono>
+#include <cstring>
+#include <thread>
+#include <unistd.h>     // sysconf
+#include "benchmark.cpp"
+#include "archivoBinario.cpp"
+#include "externo.cpp"
+#include "lotes.cpp"
+#include "dendrograma.cpp"
+#include "fuzzing.cpp"
+#include "incremental.cpp"
 
 /**
- * @brief Ejecuta un experimento de rendimiento para comparar variantes del algoritmo de Kruskal.
+ * @brief Función principal del programa.
+ *
+ * Ejecuta un benchmark de las variantes de árbol cobertor mínimo sobre grafos completos
+ * de tamaño creciente (ver `ejecutarBenchmark`). Los resultados se registran en archivos CSV.
  *
- * Esta función genera un grafo completo de N nodos con posiciones aleatorias, calcula todas las aristas posibles,
- * y luego ejecuta cuatro variantes del algoritmo de Kruskal para obtener el Árbol de Expansión Mínima (MST).
- * Se mide y compara el tiempo de ejecución de cada variante:
- * 
- * 1. Kruskal con arreglo ordenado con Union-Find sin optimizar.
- * 2. Kruskal con arreglo ordenado son Union-Find optimizado.
- * 3. Kruskal con heap con Union-Find sin optimizar.
- * 4. Kruskal con heap con Union-Find optimizado.
+ * Con `--entrada` en cambio calcula el MST de un archivo binario (ver `archivoBinario.cpp`),
+ * y con `--generar` escribe un archivo binario con 2^exp-max puntos. Con `--aproximado` compara el
+ * MST aproximado con el exacto (ver `verificarAproximado`). Con `--lote` mide el rendimiento de `LoteMST`,
+ * con `--dimension` compara las variantes sobre puntos de más coordenadas, con `--clusters` divide los puntos
+ * en clusters de enlace simple, con `--incremental` actualiza un MST por lotes (ver `MSTIncremental`) y con
+ * `--verificar` busca variantes que no entreguen un MST (ver `fuzzingDiferencial`).
  *
- * Además, verifica que todas las variantes produzcan MSTs con el mismo peso total y guarda los resultados en un archivo CSV.
+ * ### Opciones
+ * Todas son opcionales; entre paréntesis el valor por defecto.
+ * - `--exp-min i` (5) y `--exp-max i` (16): se prueban N = 2^i con i en [exp-min, exp-max].
+ * - `--exp-max-completo i` (13): sobre este exponente solo corren las variantes que no guardan aristas.
+ * - `--exp-max-precision i` (14): sobre este exponente tampoco corren `kruskal_float` ni `kruskal_entero`,
+ *   que crean aristas de 12 bytes en vez de usar las del grafo completo.
+ * - `--repeticiones r` (5): mediciones por variante y tamaño.
+ * - `--calentamiento c` (1): ejecuciones no medidas antes de medir.
+ * - `--semilla s` (42): semilla de los puntos y del orden de las variantes.
+ * - `--distribucion d` (uniforme): distribución de los puntos: `uniforme`, `clusters` o `grilla`.
+ * - `--hilos h` (núcleos de la máquina): hilos para construir el grafo y para las variantes paralelas.
+ * - `--arena a` (1): con 0 cada ejecución pide su propia memoria en vez de reutilizar la del grafo y una arena.
+ * - `--entrada ruta`: archivo binario del que se calcula el MST.
+ * - `--salida ruta`: donde se escriben los puntos y el MST de `--entrada`.
+ * - `--memoria mb`: con `--entrada`, usa Kruskal en memoria externa con a lo más esta cantidad de MB
+ *   para las aristas (ver `kruskal_externo`); las corridas temporales se crean en `--temporal` (/tmp).
+ *   Sin esta opción también se usa, con un cuarto de la memoria física, si las aristas ocupan más de la mitad.
+ * - `--generar ruta`: archivo binario donde se escriben los puntos generados.
+ * - `--aproximado eps`: genera 2^exp-max puntos y compara el peso y el tiempo de `mst_aproximado` con error
+ *   máximo `eps` contra el MST exacto, de `kruskal_array_Opti` si exp-max no supera exp-max-completo y
+ *   de `kruskal_geometrico` si no.
+ * - `--lote t`: genera t conjuntos de puntos, con N = 2^i para i en [exp-min, exp-max] de forma cíclica, y los
+ *   resuelve con `LoteMST` primero con un hilo y luego con `--hilos`, mostrando los trabajos por segundo.
+ * - `--dimension d` (2): con d distinto de 2 compara las cuatro variantes de Kruskal y el Kruskal geométrico
+ *   sobre puntos de d coordenadas (d en 3, 4, 8 o 16, ver `ejecutarBenchmarkDimension`), sin escribir CSV.
+ * - `--clusters k`: genera 2^exp-max puntos, construye el dendrograma de enlace simple de su MST (ver `Dendrograma`)
+ *   y muestra los tamaños de los k clusters y el tiempo de las consultas de corte.
+ * - `--incremental b`: genera 2^exp-max puntos y en cada uno de `--repeticiones` pasos inserta un lote de b puntos
+ *   nuevos y elimina b puntos al azar con `MSTIncremental`, comparando su peso y su tiempo con los de recalcular
+ *   el MST de los puntos activos con `kruskal_geometrico`.
+ * - `--verificar c`: ejecuta todas las variantes sobre c casos aleatorios y adversariales de hasta 2^exp-min puntos
+ *   (con la semilla `--semilla`), además de `kruskal_externo` (con archivos en `--temporal`) y `MSTIncremental`,
+ *   verifica que cada una entregue un MST y muestra las fallas.
  *
- * @param N Cantidad de nodos a generar para el grafo.
+ * ### Ejemplo de uso:
+ * @code
+ * ./exe/main --exp-max 10 --repeticiones 15
+ * ./exe/main --generar puntos.bin --exp-max 20 --distribucion clusters
+ * ./exe/main --entrada puntos.bin --salida mst.bin
+ * ./exe/main --entrada aristas.bin --memoria 512 --temporal /scratch
+ * ./exe/main --aproximado 0.05 --exp-max 20
+ * ./exe/main --lote 200 --exp-min 8 --exp-max 14 --hilos 8
+ * ./exe/main --dimension 8 --exp-max 16 --exp-max-completo 11
+ * ./exe/main --clusters 10 --exp-max 18 --distribucion clusters
+ * ./exe/main --incremental 100 --exp-max 16 --repeticiones 20
+ * ./exe/main --verificar 2000 --exp-min 8 --semilla 7
+ * @endcode
  *
- * ### CSV generado
- * La función guarda una línea por experimento en el archivo `./csv/resultados.csv`, con el siguiente formato:
- * ```
- * N, tiempo_construccion, kruskal_array, kruskal_array_uf, kruskal_heap, kruskal_heap_uf
- * ```
+ * @return 0 si el programa finaliza correctamente, 1 si hay una opción inválida, falla un archivo o falla una verificación.
  */
-void runExpirement(int N){
-    // Contar el tiempo de construcción
-    std::cout << "Creando grafo de " << N << " aristas \n";
-    auto startConstruction = std::chrono::high_resolution_clock::now();
-    
-    // Crear N nodos
-    std::vector<Node> nodos = {};
-    for (int i=0; i<N; i++) nodos.push_back(Node());
-    // Crear árbol con todas sus posibles aristas
-    Graph G(nodos);
-
-    auto endConstruction = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> constructionDuration = endConstruction - startConstruction;
-    std::cout << "Grafo construido en " << constructionDuration.count() << " segundos.\n";
-
-
-    // Buscar árbol con los cuatro métodos
-    std::cout << "Buscando árbol cobertor con un arreglo ordenado: \n";
-    auto startMSTarray = std::chrono::high_resolution_clock::now();
-    std::vector<Edge> MST_array = kruskal_array(G);
-    auto endMSTarray = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> MSTarrayDuration = endMSTarray - startMSTarray;
-    std::cout << "Arbol encontrado en " << MSTarrayDuration.count() << " segundos.\n";
-
-
-    std::cout << "Buscando árbol cobertor con un arreglo ordenado y Union-Find optimizado: \n";
-    auto startMSTarrayUF = std::chrono::high_resolution_clock::now();
-    std::vector<Edge> MST_array_opt = kruskal_array_Opti(G);
-    auto endMSTarrayUF = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> MSTarrayUFDuration = endMSTarrayUF - startMSTarrayUF;
-    std::cout << "Arbol encontrado en " << MSTarrayUFDuration.count() << " segundos.\n";
-
-    
-    std::cout << "Buscando árbol cobertor con un heap: \n";
-    auto startMSTheap = std::chrono::high_resolution_clock::now();
-    std::vector<Edge> MST_heap = kruskal_heap(G);
-    auto endMSTheap = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> MSTheapDuration = endMSTheap - startMSTheap;
-    std::cout << "Arbol encontrado en " << MSTheapDuration.count() << " segundos.\n";
-    
-
-    std::cout << "Buscando árbol cobertor con un heap y Union Find optimizado: \n";
-    auto startMSTheapUF = std::chrono::high_resolution_clock::now();
-    std::vector<Edge> MST_heap_opt = kruskal_heap_Opti(G);
-    auto endMSTheapUF = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> MSTheapUFDuration = endMSTheapUF - startMSTheapUF;
-    std::cout << "Arbol encontrado en " << MSTheapUFDuration.count() << " segundos.\n";
-    
-
-    // Verificar que todos obtuvieron el mismo peso
-    if(!mismosPesos(MST_array, MST_array_opt, MST_heap, MST_heap_opt)){
-        std::cerr << "Error: no se obtuvieron los mismos pesos\n";
-        exit(1);
+int main(int argc, char* argv[]){
+    ConfiguracionBenchmark config;
+    config.hilos = std::thread::hardware_concurrency();
+    std::string entrada, salida, generar, temporal = "/tmp";
+    size_t memoria = 0;
+    double epsilon = -1; // sin --aproximado
+    int lote = 0;
+    int dimension = 2;
+    int clusters = 0;
+    int verificar = 0;
+    int incremental = 0;
+
+    for (int i=1; i<argc; i++){
+        if (i + 1 >= argc){
+            std::cerr << "Falta el valor de la opción " << argv[i] << "\n";
+            return 1;
+        }
+        const char* opcion = argv[i];
+        long valor = std::atol(argv[++i]);
+        if (!std::strcmp(opcion, "--exp-min")) config.expMin = valor;
+        else if (!std::strcmp(opcion, "--exp-max")) config.expMax = valor;
+        else if (!std::strcmp(opcion, "--exp-max-completo")) config.expMaxCompleto = valor;
+        else if (!std::strcmp(opcion, "--exp-max-precision")) config.expMaxPrecision = valor;
+        else if (!std::strcmp(opcion, "--repeticiones")) config.repeticiones = valor;
+        else if (!std::strcmp(opcion, "--calentamiento")) config.calentamiento = valor;
+        else if (!std::strcmp(opcion, "--semilla")) config.semilla = valor;
+        else if (!std::strcmp(opcion, "--hilos")) config.hilos = valor;
+        else if (!std::strcmp(opcion, "--arena")) config.usarArena = valor != 0;
+        else if (!std::strcmp(opcion, "--entrada")) entrada = argv[i];
+        else if (!std::strcmp(opcion, "--salida")) salida = argv[i];
+        else if (!std::strcmp(opcion, "--generar")) generar = argv[i];
+        else if (!std::strcmp(opcion, "--temporal")) temporal = argv[i];
+        else if (!std::strcmp(opcion, "--memoria")) memoria = (size_t)valor << 20;
+        else if (!std::strcmp(opcion, "--aproximado")) epsilon = std::atof(argv[i]);
+        else if (!std::strcmp(opcion, "--lote")) lote = valor;
+        else if (!std::strcmp(opcion, "--dimension")) dimension = valor;
+        else if (!std::strcmp(opcion, "--clusters")) clusters = valor;
+        else if (!std::strcmp(opcion, "--verificar")) verificar = valor;
+        else if (!std::strcmp(opcion, "--incremental")) incremental = valor;
+        else if (!std::strcmp(opcion, "--distribucion")){
+            if (!distribucionPorNombre(argv[i], config.distribucion)){
+                std::cerr << "Distribución desconocida: " << argv[i] << "\n";
+                return 1;
+            }
+        }
+        else {
+            std::cerr << "Opción desconocida: " << opcion << "\n";
+            return 1;
+        }
     }
 
-    // Mostrar resultados
-    std::cout << "\n-------------------------Resultados del experimento:-------------------------\n";
-    std::cout <<   "|   Tamaño del input: " << N << " puntos.       \n";
-    std::cout <<   "|   Tiempo de creación del grafo: " << constructionDuration.count() << " segundos.\n";
-    std::cout <<   "|   Tiempo de Kruskal sin optimización find y usando un arreglo ordenado: " << MSTarrayDuration.count() << " segundos.  \n";
-    std::cout <<   "|   Tiempo de Kruskal con optimización find y usando un arreglo ordenado: " << MSTarrayUFDuration.count() << " segundos.\n";
-    std::cout <<   "|   Tiempo de Kruskal sin optimización find y usando un heap: " << MSTheapDuration.count() << " segundos. \n";
-    std::cout <<   "|   Tiempo de Kruskal con optimización find y usando un heap: " << MSTheapUFDuration.count() << " segundos. \n";
-    std::cout <<   "-----------------------------------------------------------------------------\n";
-
-    // Guardar resumen de datos como csv
-    std::ofstream data("./csv/resultados.csv", std::ios::app);
-    if(data){
-        data << N << "," 
-             << constructionDuration.count() << "," 
-             << MSTarrayDuration.count() << "," 
-             << MSTarrayUFDuration.count() << "," 
-             << MSTheapDuration.count() << "," 
-             << MSTheapUFDuration.count() << "\n";
-    } else {
-        std::cerr << "No se pudo escribir el resumen en 'resultados.csv'\n";
+    if (!generar.empty()){
+        std::vector<Node> V = generarPuntos(1 << config.expMax, config.semilla, config.distribucion, config.hilos);
+        for (size_t k=0; k<V.size(); k++) V[k].id = k;
+        return escribirArchivoMST(generar, V, {}) ? 0 : 1;
     }
-}
 
+    if (epsilon >= 0){
+        int N = 1 << config.expMax;
+        std::vector<Node> V = generarPuntos(N, config.semilla, config.distribucion, config.hilos);
+        for (int k=0; k<N; k++) V[k].id = k;
 
-/**
- * @brief Función principal del programa.
- *
- * Ejecuta una serie de experimentos para medir el rendimiento de distintas variantes
- * del algoritmo de Kruskal sobre grafos completos de tamaño creciente. Los resultados
- * se registran en un archivo CSV.
- *
- * ### Detalles del experimento:
- * - Se prueban tamaños de entrada N = 2^i con i en [5, 13] (de 32 a 8192 nodos).
- * - Cada tamaño se ejecuta 5 veces.
- *
- * @return 0 si el programa finaliza correctamente.
- */
-int main(){
-    for(int i=5; i<=13; i++){
-        int N = std::pow(2, i);
-        for(int j=0; j<5; j++){
-            runExpirement(N);
+        auto inicio = std::chrono::steady_clock::now();
+        std::vector<Edge> exacto;
+        if (config.expMax <= config.expMaxCompleto){
+            Graph G(V, config.hilos);
+            exacto = kruskal_array_Opti(G);
+            for (Edge& e : exacto) e = Edge(&V[e.n1->id], &V[e.n2->id]); // G se destruye
+        } else {
+            exacto = kruskal_geometrico(V);
         }
+        double tiempoExacto = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        inicio = std::chrono::steady_clock::now();
+        VerificacionAproximada r = verificarAproximado(V, exacto, epsilon);
+        double tiempoAproximado = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        std::cout << "N = " << N << ", puntos " << nombreDistribucion(config.distribucion) << "\n"
+                  << "exacto: peso = " << r.pesoExacto << ", tiempo = " << tiempoExacto << " s\n"
+                  << "aproximado: peso = " << r.pesoAproximado << ", tiempo = " << tiempoAproximado << " s\n"
+                  << "error relativo = " << r.errorRelativo << " (cota " << r.cota << ")\n";
+        return r.errorRelativo <= r.cota + 1e-12 ? 0 : 1;
     }
+
+    if (lote > 0){
+        std::vector<std::vector<Node>> puntos;
+        for (int k=0; k<lote; k++){
+            int N = 1 << (config.expMin + k % (config.expMax - config.expMin + 1));
+            puntos.push_back(generarPuntos(N, config.semilla * 1000003 + k, config.distribucion, config.hilos));
+        }
+
+        std::vector<double> pesos;
+        for (int hilos : {1, config.hilos}){
+            LoteMST trabajos;
+            for (const std::vector<Node>& V : puntos) trabajos.agregar(V);
+            auto inicio = std::chrono::steady_clock::now();
+            std::vector<ResultadoMST> resultados = trabajos.resolver(hilos);
+            double tiempo = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+            double tiempoTrabajos = 0;
+            for (int k=0; k<lote; k++){
+                double peso = 0;
+                for (const Edge& e : resultados[k].mst) peso += e.peso;
+                if (hilos == 1) pesos.push_back(peso);
+                else if (peso != pesos[k]){
+                    std::cerr << "Error: el trabajo " << k << " obtuvo peso " << peso << " con " << hilos
+                              << " hilos y " << pesos[k] << " con uno\n";
+                    return 1;
+                }
+                tiempoTrabajos += resultados[k].tiempo;
+            }
+            std::cout << hilos << " hilo(s): " << lote << " trabajos en " << tiempo << " s, "
+                      << lote / tiempo << " trabajos/s (suma de los trabajos: " << tiempoTrabajos << " s)\n";
+        }
+        return 0;
+    }
+
+    if (verificar > 0){
+        auto inicio = std::chrono::steady_clock::now();
+        std::vector<FallaVerificacion> fallas = fuzzingDiferencial(verificar, config.semilla, 1 << config.expMin, config.hilos, temporal);
+        double tiempo = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        for (const FallaVerificacion& f : fallas){
+            std::cout << f.variante << ": " << nombreCaso(f.caso) << ", N = " << f.N << ", semilla " << f.semilla << ": " << f.motivo << "\n";
+        }
+        std::cout << verificar << " casos con " << variantesRegistradas(config.hilos).size() << " variantes, kruskal_externo y MSTIncremental en " << tiempo << " s, "
+                  << fallas.size() << " falla(s)\n";
+        return fallas.empty() ? 0 : 1;
+    }
+
+    if (incremental > 0){
+        int N = 1 << config.expMax;
+        MSTIncremental mst(generarPuntos(N, config.semilla, config.distribucion, config.hilos));
+        Xoshiro256 gen(config.semilla, 1);
+        std::vector<int> ids(N); // ids de los puntos activos
+        for (int k=0; k<N; k++) ids[k] = k;
+
+        double tiempoIncremental = 0, tiempoRecalcular = 0;
+        for (int paso=0; paso<config.repeticiones; paso++){
+            std::vector<Node> lote = generarPuntos(incremental, config.semilla * 1000003 + paso + 1, config.distribucion);
+            auto inicio = std::chrono::steady_clock::now();
+            std::vector<int> nuevos = mst.insertar(lote);
+            for (int k=0; k<incremental && ids.size() > 1; k++){
+                size_t i = gen.siguiente() % ids.size();
+                mst.eliminar(ids[i]);
+                ids[i] = ids.back();
+                ids.pop_back();
+            }
+            tiempoIncremental += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+            ids.insert(ids.end(), nuevos.begin(), nuevos.end());
+
+            std::vector<Node> activos;
+            for (int id : ids) activos.push_back(mst.nodos()[id]);
+            for (size_t k=0; k<activos.size(); k++) activos[k].id = k;
+            inicio = std::chrono::steady_clock::now();
+            double peso = pesoTotal(kruskal_geometrico(activos));
+            tiempoRecalcular += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+            if (mst.size() != (int)activos.size() || !pesosIguales(mst.peso(), peso, activos.size())){
+                std::cerr << "Error: en el paso " << paso << " MSTIncremental tiene " << mst.size() << " puntos y peso " << mst.peso()
+                          << ", y kruskal_geometrico sobre " << activos.size() << " puntos obtuvo " << peso << "\n";
+                return 1;
+            }
+        }
+        std::cout << "N = " << N << ", puntos " << nombreDistribucion(config.distribucion) << ", " << config.repeticiones
+                  << " pasos de " << incremental << " inserciones y " << incremental << " eliminaciones\n"
+                  << "incremental: " << tiempoIncremental / std::max(config.repeticiones, 1) << " s por paso, "
+                  << "recalcular: " << tiempoRecalcular / std::max(config.repeticiones, 1) << " s por paso\n";
+        return 0;
+    }
+
+    if (clusters > 0){
+        int N = 1 << config.expMax;
+        std::vector<Node> V = generarPuntos(N, config.semilla, config.distribucion, config.hilos);
+        for (int k=0; k<N; k++) V[k].id = k;
+
+        auto inicio = std::chrono::steady_clock::now();
+        std::vector<Edge> mst = kruskal_geometrico(V);
+        double tiempoMST = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        inicio = std::chrono::steady_clock::now();
+        Dendrograma dendrograma(mst, N);
+        double tiempoDendrograma = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        // Se corta a todas las alturas del MST de a saltos, como al buscar el número de clusters. Cada corte
+        // debe dar tantos clusters distintos como indica `clustersEnAltura`, que no recorre los puntos
+        const int CORTES = N > 1 ? 100 : 0;
+        inicio = std::chrono::steady_clock::now();
+        int cortesErroneos = 0;
+        for (int c=0; c<CORTES; c++){
+            double altura = dendrograma.uniones()[(size_t)(N - 2) * c / CORTES].altura;
+            std::vector<int> corte = dendrograma.cortarEnAltura(altura);
+            if (*std::max_element(corte.begin(), corte.end()) + 1 != dendrograma.clustersEnAltura(altura)) cortesErroneos++;
+        }
+        double tiempoCortes = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        std::vector<int> etiquetas = dendrograma.etiquetas(clusters);
+        std::vector<int> tamanos(std::min(clusters, N));
+        for (int c : etiquetas) tamanos[c]++;
+        std::sort(tamanos.rbegin(), tamanos.rend());
+
+        std::cout << "N = " << N << ", puntos " << nombreDistribucion(config.distribucion) << "\n"
+                  << "MST: " << tiempoMST << " s, dendrograma: " << tiempoDendrograma << " s, "
+                  << "corte: " << tiempoCortes / std::max(CORTES, 1) << " s en promedio (" << CORTES << " alturas)\n"
+                  << "tamaños de los " << tamanos.size() << " clusters:";
+        for (size_t c=0; c<tamanos.size() && c<20; c++) std::cout << " " << tamanos[c];
+        std::cout << (tamanos.size() > 20 ? " ...\n" : "\n");
+        if (cortesErroneos > 0){
+            std::cerr << "Error: " << cortesErroneos << " de " << CORTES << " cortes no tienen el número de clusters de clustersEnAltura\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!entrada.empty()){
+        ArchivoMST archivo;
+        if (!archivo.abrir(entrada)) return 1;
+        // Ordenar desde el mapeo lee las aristas en desorden: si no caben en la mitad de la memoria física
+        // se leerían del disco una y otra vez, así que se usa Kruskal en memoria externa
+        size_t memoriaFisica = (size_t)sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGE_SIZE);
+        if (memoria == 0 && archivo.numAristas() * sizeof(AristaBinaria) > memoriaFisica / 2){
+            memoria = memoriaFisica / 4;
+            std::cerr << "Las aristas no caben en memoria; se usa Kruskal en memoria externa con " << (memoria >> 20) << " MB\n";
+        }
+        auto inicio = std::chrono::steady_clock::now();
+        std::vector<AristaBinaria> mst = (memoria > 0 && archivo.numAristas() > 0)
+            ? kruskal_externo(entrada, memoria, temporal) : mstDeArchivo(archivo);
+        double tiempo = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+        if (archivo.numPuntos() > 1 && mst.size() != archivo.numPuntos() - 1){
+            std::cerr << "El grafo de '" << entrada << "' no es conexo o tiene aristas inválidas\n";
+            return 1;
+        }
+
+        double peso = 0;
+        for (const AristaBinaria& a : mst) peso += a.peso;
+        std::cout << "N = " << archivo.numPuntos() << ", aristas = " << archivo.numAristas()
+                  << ", peso del MST = " << peso << ", tiempo = " << tiempo << " s\n";
+        if (!salida.empty() && !escribirArchivoMST(salida, archivo.puntos(), archivo.numPuntos(), nullptr, 0, mst.data(), mst.size())) return 1;
+        return 0;
+    }
+
+    if (dimension != 2) return ejecutarBenchmarkDimension(dimension, config) ? 0 : 1;
+    ejecutarBenchmark(config);
     return 0;
-}
\ No newline at end of file
+}
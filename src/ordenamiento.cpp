@@ -0,0 +1,183 @@
+#pragma once
+#include <algorithm>    // std::sort, std::merge
+#include <cstdint>
+#include <cstring>      // std::memcpy
+#include <thread>
+#include "aux_f.cpp"
+#include "arena.cpp"
+
+/**
+ * @brief Métodos disponibles para ordenar las aristas por peso.
+ */
+enum MetodoOrden {
+    ORDEN_STD,       // std::sort secuencial con `sortByWeight`
+    ORDEN_PARALELO,  // merge sort paralelo: se ordenan bloques por hilo y se mezclan de a pares
+    ORDEN_RADIX,     // radix sort LSD paralelo sobre los bits IEEE-754 del peso
+    ORDEN_PARCIAL    // selección incremental: Kruskal solo ordena los bloques de aristas livianas que alcanza a usar
+};
+
+/**
+ * @brief Nombre del método de ordenamiento, para mostrarlo en los resultados.
+ */
+const char* nombreOrden(MetodoOrden metodo){
+    switch (metodo){
+        case ORDEN_PARALELO: return "merge sort paralelo";
+        case ORDEN_RADIX: return "radix sort paralelo";
+        case ORDEN_PARCIAL: return "selección incremental";
+        default: return "std::sort";
+    }
+}
+
+/**
+ * @brief Ordena las aristas por peso con un merge sort paralelo.
+ *
+ * Divide el arreglo en `hilos` bloques que se ordenan en paralelo con `std::sort`,
+ * y luego los mezcla de a pares, también en paralelo, hasta que queda un solo bloque.
+ *
+ * @tparam Aristas Vector de `EdgeD` de cualquier dimensión, con cualquier asignador; el buffer auxiliar usa el mismo.
+ * @param edges Aristas por ordenar, se ordenan en su lugar.
+ * @param hilos Número de hilos a usar.
+ */
+template <class Aristas>
+void ordenarParalelo(Aristas& edges, int hilos){
+    size_t m = edges.size();
+    if (hilos < 1) hilos = 1;
+    if (hilos == 1 || m < 2 * (size_t)hilos){
+        std::sort(edges.begin(), edges.end(), sortByWeight);
+        return;
+    }
+
+    // Límites de los bloques: el bloque b es [limites[b], limites[b+1])
+    std::vector<size_t> limites;
+    for (int b=0; b<=hilos; b++) limites.push_back(m * b / hilos);
+
+    std::vector<std::thread> trabajadores;
+    for (int b=0; b<hilos; b++){
+        trabajadores.push_back(std::thread([&edges, &limites, b](){
+            std::sort(edges.begin() + limites[b], edges.begin() + limites[b+1], sortByWeight);
+        }));
+    }
+    for (std::thread& t : trabajadores) t.join();
+
+    Aristas buffer(m, typename Aristas::value_type(), edges.get_allocator());
+    Aristas* origen = &edges;
+    Aristas* destino = &buffer;
+    while (limites.size() > 2){
+        std::vector<size_t> nuevos;
+        trabajadores.clear();
+        for (size_t b=0; b+1<limites.size(); b+=2){
+            size_t ini = limites[b];
+            size_t med = limites[b+1];
+            size_t fin = (b+2 < limites.size()) ? limites[b+2] : med; // bloque sin pareja
+            nuevos.push_back(ini);
+            trabajadores.push_back(std::thread([origen, destino, ini, med, fin](){
+                std::merge(origen->begin() + ini, origen->begin() + med,
+                           origen->begin() + med, origen->begin() + fin,
+                           destino->begin() + ini, sortByWeight);
+            }));
+        }
+        nuevos.push_back(m);
+        for (std::thread& t : trabajadores) t.join();
+        std::swap(origen, destino);
+        limites = nuevos;
+    }
+    if (origen != &edges) edges.swap(buffer);
+}
+
+/**
+ * @brief Ordena las aristas por peso con un radix sort LSD paralelo.
+ *
+ * Como los pesos son reales no negativos, el orden de sus bits IEEE-754 vistos como
+ * enteros sin signo coincide con el orden de los pesos. Se ordena por dígitos de 16 bits,
+ * del menos al más significativo, y se saltan los dígitos que son iguales en todas las aristas.
+ * En cada pasada cada hilo cuenta los dígitos de su bloque y luego los reparte en su lugar,
+ * por lo que el ordenamiento es estable.
+ *
+ * @tparam Aristas Vector de `EdgeD` de cualquier dimensión, con cualquier asignador; el buffer auxiliar usa el mismo.
+ * @param edges Aristas por ordenar, se ordenan en su lugar.
+ * @param hilos Número de hilos a usar.
+ */
+template <class Aristas>
+void ordenarRadix(Aristas& edges, int hilos){
+    const int BITS = 16;
+    const size_t CUBETAS = 1 << BITS;
+    size_t m = edges.size();
+    if (hilos < 1) hilos = 1;
+    if (m < 2) return;
+    if (m < (size_t)hilos * CUBETAS) hilos = 1; // con pocos elementos no vale la pena repartir
+
+    auto clave = [](const typename Aristas::value_type& e){
+        uint64_t bits;
+        std::memcpy(&bits, &e.peso, sizeof(bits));
+        return bits;
+    };
+
+    std::vector<size_t> limites;
+    for (int t=0; t<=hilos; t++) limites.push_back(m * t / hilos);
+
+    Aristas buffer(m, typename Aristas::value_type(), edges.get_allocator());
+    Aristas* origen = &edges;
+    Aristas* destino = &buffer;
+    std::vector<std::vector<size_t>> conteo(hilos, std::vector<size_t>(CUBETAS));
+
+    for (int corrimiento=0; corrimiento<64; corrimiento+=BITS){
+        std::vector<std::thread> trabajadores;
+        for (int t=0; t<hilos; t++){
+            trabajadores.push_back(std::thread([&, t](){
+                std::fill(conteo[t].begin(), conteo[t].end(), 0);
+                for (size_t k=limites[t]; k<limites[t+1]; k++){
+                    conteo[t][(clave((*origen)[k]) >> corrimiento) & (CUBETAS - 1)]++;
+                }
+            }));
+        }
+        for (std::thread& t : trabajadores) t.join();
+
+        // Si todas las aristas tienen el mismo dígito la pasada no cambia nada
+        size_t digito = (clave((*origen)[0]) >> corrimiento) & (CUBETAS - 1);
+        size_t total = 0;
+        for (int t=0; t<hilos; t++) total += conteo[t][digito];
+        if (total == m) continue;
+
+        // Posición inicial de cada hilo en cada cubeta
+        size_t posicion = 0;
+        for (size_t c=0; c<CUBETAS; c++){
+            for (int t=0; t<hilos; t++){
+                size_t cantidad = conteo[t][c];
+                conteo[t][c] = posicion;
+                posicion += cantidad;
+            }
+        }
+
+        trabajadores.clear();
+        for (int t=0; t<hilos; t++){
+            trabajadores.push_back(std::thread([&, t](){
+                for (size_t k=limites[t]; k<limites[t+1]; k++){
+                    const auto& e = (*origen)[k];
+                    (*destino)[conteo[t][(clave(e) >> corrimiento) & (CUBETAS - 1)]++] = e;
+                }
+            }));
+        }
+        for (std::thread& t : trabajadores) t.join();
+        std::swap(origen, destino);
+    }
+    if (origen != &edges) edges.swap(buffer);
+}
+
+/**
+ * @brief Ordena las aristas por peso en orden ascendente con el método indicado.
+ *
+ * `ORDEN_PARCIAL` solo tiene sentido dentro de Kruskal (ver `kruskal_array_parcial`); aquí ordena todo con `std::sort`.
+ *
+ * @tparam Aristas Vector de `EdgeD` de cualquier dimensión, con cualquier asignador.
+ * @param edges Aristas por ordenar, se ordenan en su lugar.
+ * @param metodo Método de ordenamiento.
+ * @param hilos Número de hilos; solo lo usan los métodos paralelos.
+ */
+template <class Aristas>
+void ordenarAristas(Aristas& edges, MetodoOrden metodo, int hilos){
+    switch (metodo){
+        case ORDEN_PARALELO: ordenarParalelo(edges, hilos); break;
+        case ORDEN_RADIX: ordenarRadix(edges, hilos); break;
+        default: std::sort(edges.begin(), edges.end(), sortByWeight);
+    }
+}
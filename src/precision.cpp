@@ -0,0 +1,310 @@
+#pragma once
+#include <algorithm>    // std::max, std::min
+#include <cmath>
+#include <cstdint>
+#include <cstring>      // std::memcpy
+#include <limits>
+#include <type_traits>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+#include "UnionFind.cpp"
+#include "aux_f.cpp"
+#include "arena.cpp"
+
+// Grafos completos con pesos de menor precisión que `double`.
+//
+// El tipo del peso T puede ser:
+// - `double`: los mismos pesos que `Graph`, sirve como referencia.
+// - `float`: coordenadas y pesos de 32 bits.
+// - `uint32_t`: pesos en punto fijo, calculados en double y escalados al rango de 32 bits.
+//
+// Con float o uint32_t cada arista ocupa 12 bytes en vez de los 24 de `Edge`, y las claves de 32 bits
+// se ordenan con dos pasadas de radix sort. Las distancias de cada fila se calculan con instrucciones
+// SIMD (AVX-512 o AVX2, según con qué se compile, por ejemplo con -march=native) o con un ciclo escalar.
+//
+// Con uint32_t cada peso se calcula en double y luego se redondea; como redondear es monótono, el orden
+// de las aristas solo cambia entre pesos que quedan empatados, así que el árbol obtenido es un MST de los
+// pesos redondeados. Con float, en cambio, las coordenadas ya se redondean y la distancia se calcula con
+// aritmética de 32 bits, lo que no es un redondeo monótono del peso en double: dos aristas de pesos
+// distintos pueden quedar en el orden contrario. El árbol es entonces solo aproximado; `verificarPrecision`
+// y la tolerancia del benchmark miden cuánto se aleja su peso real del óptimo.
+
+/**
+ * @brief Propiedades de cada tipo de peso.
+ */
+template <class T> struct RasgosPeso;
+
+template <> struct RasgosPeso<double> {
+    typedef double Coordenada;
+    static const char* nombre(){ return "double"; }
+};
+
+template <> struct RasgosPeso<float> {
+    typedef float Coordenada;
+    static const char* nombre(){ return "float"; }
+};
+
+template <> struct RasgosPeso<uint32_t> {
+    typedef double Coordenada;
+    static const char* nombre(){ return "entero"; }
+};
+
+/**
+ * @brief Arista con peso de tipo T e ids de 32 bits.
+ */
+template <class T>
+struct AristaPrecision {
+    T peso;
+    uint32_t u;
+    uint32_t v;
+};
+
+/**
+ * @brief Calcula las distancias cuadradas de un punto a un arreglo de puntos.
+ *
+ * `salida[k] = (xs[k] - x)^2 + (ys[k] - y)^2` para k en [0, n).
+ */
+void distanciasFila(const float* xs, const float* ys, size_t n, float x, float y, float* salida){
+    size_t k = 0;
+#if defined(__AVX512F__)
+    __m512 px = _mm512_set1_ps(x), py = _mm512_set1_ps(y);
+    for (; k + 16 <= n; k += 16){
+        __m512 dx = _mm512_sub_ps(_mm512_loadu_ps(xs + k), px);
+        __m512 dy = _mm512_sub_ps(_mm512_loadu_ps(ys + k), py);
+        _mm512_storeu_ps(salida + k, _mm512_add_ps(_mm512_mul_ps(dx, dx), _mm512_mul_ps(dy, dy)));
+    }
+#elif defined(__AVX2__)
+    __m256 px = _mm256_set1_ps(x), py = _mm256_set1_ps(y);
+    for (; k + 8 <= n; k += 8){
+        __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + k), px);
+        __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + k), py);
+        _mm256_storeu_ps(salida + k, _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+    }
+#endif
+    for (; k < n; k++){
+        float dx = xs[k] - x, dy = ys[k] - y;
+        salida[k] = dx * dx + dy * dy;
+    }
+}
+
+/**
+ * @brief Versión en double de `distanciasFila`.
+ */
+void distanciasFila(const double* xs, const double* ys, size_t n, double x, double y, double* salida){
+    size_t k = 0;
+#if defined(__AVX512F__)
+    __m512d px = _mm512_set1_pd(x), py = _mm512_set1_pd(y);
+    for (; k + 8 <= n; k += 8){
+        __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(xs + k), px);
+        __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(ys + k), py);
+        _mm512_storeu_pd(salida + k, _mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)));
+    }
+#elif defined(__AVX2__)
+    __m256d px = _mm256_set1_pd(x), py = _mm256_set1_pd(y);
+    for (; k + 4 <= n; k += 4){
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + k), px);
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + k), py);
+        _mm256_storeu_pd(salida + k, _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+    }
+#endif
+    for (; k < n; k++){
+        double dx = xs[k] - x, dy = ys[k] - y;
+        salida[k] = dx * dx + dy * dy;
+    }
+}
+
+/**
+ * @class GrafoPrecision
+ * @brief Grafo completo con pesos de tipo T, guardados como arreglo de `AristaPrecision<T>`.
+ *
+ * Las aristas quedan en el mismo orden que en `Graph`. Para pesos enteros se usa la escala que lleva
+ * el cuadrado de la diagonal de la caja envolvente de los puntos al mayor entero de 32 bits.
+ *
+ * @tparam T Tipo del peso: `double`, `float` o `uint32_t`.
+ */
+template <class T>
+class GrafoPrecision {
+public:
+    typedef typename RasgosPeso<T>::Coordenada Coordenada;
+
+    std::vector<Coordenada> x, y;          // Coordenadas de los nodos
+    VectorArena<AristaPrecision<T>> E;     // Lista de aristas; sale de la arena activa, si hay una
+    double escala = 1;                     // Solo para pesos enteros: peso ≈ distancia cuadrada * escala
+
+    /**
+     * @brief Crea las N(N-1)/2 aristas entre los nodos, repartiendo las filas entre los hilos.
+     *
+     * @param V Nodos del grafo, en el orden de sus ids.
+     * @param hilos Número de hilos a usar.
+     */
+    GrafoPrecision(const std::vector<Node>& V, int hilos = 1){
+        size_t n = V.size();
+        x.resize(n);
+        y.resize(n);
+        double minX = std::numeric_limits<double>::infinity(), maxX = -minX, minY = minX, maxY = -minX;
+        for (size_t i=0; i<n; i++){
+            x[i] = V[i].x;
+            y[i] = V[i].y;
+            minX = std::min(minX, V[i].x); maxX = std::max(maxX, V[i].x);
+            minY = std::min(minY, V[i].y); maxY = std::max(maxY, V[i].y);
+        }
+        if (n < 2) return;
+        if constexpr (std::is_same<T, uint32_t>::value){
+            double diagonal = (maxX - minX) * (maxX - minX) + (maxY - minY) * (maxY - minY);
+            escala = diagonal > 0 ? (double)UINT32_MAX / diagonal : 1;
+        }
+
+        E.resize(n * (n - 1) / 2);
+        if (hilos < 1) hilos = 1;
+        // Las filas se reparten de forma intercalada para que cada hilo cree una cantidad similar de aristas
+        enParalelo(hilos, hilos, [&](size_t, size_t, int t){
+            std::vector<Coordenada> fila(n);
+            for (size_t i=t; i<n; i+=hilos){
+                size_t k = i * n - i * (i + 1) / 2; // posición de la arista (i, i+1)
+                size_t m = n - 1 - i;
+                distanciasFila(x.data() + i + 1, y.data() + i + 1, m, x[i], y[i], fila.data());
+                for (size_t j=0; j<m; j++) E[k + j] = {convertir(fila[j]), (uint32_t)i, (uint32_t)(i + 1 + j)};
+            }
+        });
+    }
+
+    /**
+     * @brief Convierte una distancia cuadrada al tipo del peso.
+     */
+    T convertir(Coordenada d) const {
+        if constexpr (std::is_same<T, uint32_t>::value){
+            double q = d * escala;
+            return q >= (double)UINT32_MAX ? UINT32_MAX : (uint32_t)q;
+        } else {
+            return d;
+        }
+    }
+};
+
+/**
+ * @brief Ordena aristas por peso con un radix sort LSD de dígitos de 16 bits sobre los bits del peso.
+ *
+ * Sirve porque los pesos son no negativos: sus bits vistos como enteros sin signo tienen el mismo orden.
+ * Con pesos de 32 bits son solo dos pasadas.
+ */
+template <class T>
+void ordenarPorPeso(VectorArena<AristaPrecision<T>>& E){
+    typedef typename std::conditional<sizeof(T) == 8, uint64_t, uint32_t>::type Clave;
+    const int BITS = 16;
+    const size_t CUBETAS = 1 << BITS;
+    size_t m = E.size();
+    contarOrdenadas(m);
+    if (m < CUBETAS){ // con pocas aristas contar las cubetas cuesta más que ordenar
+        std::sort(E.begin(), E.end(), [](const AristaPrecision<T>& a, const AristaPrecision<T>& b){ return a.peso < b.peso; });
+        return;
+    }
+
+    auto clave = [](const AristaPrecision<T>& e){
+        Clave bits;
+        std::memcpy(&bits, &e.peso, sizeof(bits));
+        return bits;
+    };
+
+    VectorArena<AristaPrecision<T>> buffer(m, AristaPrecision<T>(), E.get_allocator());
+    std::vector<size_t> conteo(CUBETAS);
+    for (int corrimiento=0; corrimiento<(int)(8 * sizeof(Clave)); corrimiento+=BITS){
+        std::fill(conteo.begin(), conteo.end(), 0);
+        for (const AristaPrecision<T>& e : E) conteo[(clave(e) >> corrimiento) & (CUBETAS - 1)]++;
+        if (conteo[(clave(E[0]) >> corrimiento) & (CUBETAS - 1)] == m) continue; // la pasada no cambia nada
+
+        size_t posicion = 0;
+        for (size_t c=0; c<CUBETAS; c++){
+            size_t cantidad = conteo[c];
+            conteo[c] = posicion;
+            posicion += cantidad;
+        }
+        for (const AristaPrecision<T>& e : E) buffer[conteo[(clave(e) >> corrimiento) & (CUBETAS - 1)]++] = e;
+        E.swap(buffer);
+    }
+}
+
+/**
+ * @brief Kruskal con Union-Find optimizado sobre un grafo con pesos de tipo T.
+ *
+ * Ordena `G.E` en su lugar con `ordenarPorPeso`.
+ *
+ * @param G Grafo de entrada; sus aristas quedan ordenadas.
+ * @return Aristas del MST, ordenadas por su peso de tipo T.
+ */
+template <class T>
+std::vector<AristaPrecision<T>> kruskal_precision(GrafoPrecision<T>& G){
+    MedidorFase medidor;
+    ordenarPorPeso(G.E);
+    medidor.terminar(&TiemposFases::orden);
+
+    int n = G.x.size();
+    std::vector<AristaPrecision<T>> result;
+
+    UnionFind uf(n);
+
+    for (const AristaPrecision<T>& edge : G.E){
+        CONTAR(aristasExaminadas, 1);
+        int raiz_x = uf.find(edge.u);
+        int raiz_y = uf.find(edge.v);
+
+        if (raiz_x != raiz_y) {
+            uf.union_(raiz_x, raiz_y);
+            result.push_back(edge);
+            if (result.size() == n - 1) break; // cuando se encuentran n-1 aristas se termina
+        }
+    }
+    medidor.terminar(&TiemposFases::unionFind);
+    return result;
+}
+
+/**
+ * @brief Kruskal con pesos de tipo T sobre los nodos de un grafo.
+ *
+ * Crea el `GrafoPrecision<T>` (se mide como la etapa de copia) y entrega el MST como aristas entre los nodos,
+ * con sus pesos exactos en double, para poder compararlo con las demás variantes. Solo necesita los nodos,
+ * así que se puede usar con los de un `ImplicitGraph` cuando el `Graph` en double no cabe en memoria.
+ *
+ * @param V Nodos del grafo; `V[i].id` debe ser `i`.
+ * @param hilos Número de hilos para crear las aristas.
+ * @return Aristas del árbol obtenido, ordenadas por peso.
+ */
+template <class T>
+std::vector<Edge> kruskal_precision(std::vector<Node>& V, int hilos){
+    MedidorFase medidor;
+    GrafoPrecision<T> GP(V, hilos);
+    medidor.terminar(&TiemposFases::copia);
+
+    std::vector<Edge> result;
+    for (const AristaPrecision<T>& e : kruskal_precision(GP)) result.push_back(Edge(&V[e.u], &V[e.v]));
+    std::sort(result.begin(), result.end(), sortByWeight); // el orden en T puede tener empates
+    return result;
+}
+
+/**
+ * @brief Resultado de comparar el MST con pesos de tipo T contra el MST exacto.
+ */
+struct VerificacionPrecision {
+    double pesoExacto = 0;       // peso del MST calculado en double
+    double pesoObtenido = 0;     // peso real (en double) del árbol obtenido con pesos de tipo T
+    double errorRelativo = 0;    // (pesoObtenido - pesoExacto) / pesoExacto, nunca negativo
+};
+
+/**
+ * @brief Compara el MST con pesos de tipo T contra el MST en double de los mismos nodos.
+ *
+ * El peso del árbol obtenido se vuelve a calcular con `distanciaCuadrada`, así que la diferencia
+ * mide solo cuánto empeora el árbol elegido, no el error de redondeo al sumar.
+ *
+ * @param G Grafo de entrada.
+ * @param mstExacto MST de `G` calculado en double, por ejemplo con `kruskal_array_Opti`.
+ * @param hilos Número de hilos para crear las aristas.
+ */
+template <class T>
+VerificacionPrecision verificarPrecision(Graph& G, const std::vector<Edge>& mstExacto, int hilos = 1){
+    VerificacionPrecision r;
+    for (const Edge& e : mstExacto) r.pesoExacto += e.peso;
+    for (const Edge& e : kruskal_precision<T>(G.V, hilos)) r.pesoObtenido += e.peso;
+    if (r.pesoExacto > 0) r.errorRelativo = std::max(0.0, (r.pesoObtenido - r.pesoExacto) / r.pesoExacto);
+    return r;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <limits>
+#include "aux_f.cpp"
+
+/**
+ * @brief Implementación del algoritmo de Prim denso sobre un grafo implícito.
+ *
+ * Esta función construye un árbol de expansión mínima (MST) sin materializar las aristas del grafo completo.
+ * Mantiene, para cada nodo fuera del árbol, la arista más liviana que lo conecta al árbol, y en cada
+ * paso agrega el nodo más cercano. Toma O(N^2) tiempo y O(N) memoria.
+ *
+ * Las aristas resultantes se ordenan por peso, de modo que el resultado coincide con el de `kruskal_array_Opti`.
+ *
+ * @param G Grafo implícito de entrada, que contiene solo el conjunto de nodos (`G.V`).
+ * @return Un vector con las aristas que conforman el árbol de expansión mínima del grafo.
+ */
+std::vector<Edge> prim_denso(ImplicitGraph& G){
+    int n = G.V.size();
+    std::vector<Edge> result;
+    if (n < 2) return result;
+    result.reserve(n - 1);
+
+    std::vector<double> distancia(n, std::numeric_limits<double>::infinity()); // arista más liviana hacia el árbol
+    std::vector<int> padre(n, -1);      // extremo en el árbol de esa arista
+    std::vector<char> enArbol(n, 0);
+
+    int actual = 0;
+    enArbol[actual] = 1;
+    for (int k=1; k<n; k++){
+        int siguiente = -1;
+        double mejor = std::numeric_limits<double>::infinity();
+
+        for (int v=0; v<n; v++){
+            if (enArbol[v]) continue;
+            double d = G.peso(actual, v); // se actualiza con el último nodo agregado
+            if (d < distancia[v]){
+                distancia[v] = d;
+                padre[v] = actual;
+            }
+            if (distancia[v] < mejor){
+                mejor = distancia[v];
+                siguiente = v;
+            }
+        }
+
+        enArbol[siguiente] = 1;
+        result.push_back(G.arista(padre[siguiente], siguiente));
+        actual = siguiente;
+    }
+
+    std::sort(result.begin(), result.end(), sortByWeight);
+    return result;
+}
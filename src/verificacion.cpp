@@ -0,0 +1,97 @@
+#pragma once
+#include <sstream>
+#include <string>
+#include <vector>
+#include "UnionFind.cpp"
+#include "dendrograma.cpp"
+
+/**
+ * @brief Resultado de verificar un árbol cobertor.
+ */
+struct CertificadoMST {
+    bool valido = true;
+    std::string motivo;     // por qué no es válido; vacío si lo es
+};
+
+/**
+ * @brief Verifica que un conjunto de aristas sea un árbol cobertor de N nodos.
+ *
+ * Comprueba que tenga N-1 aristas, que los ids de sus nodos estén en [0, N), que no haya self-loops,
+ * que el peso de cada arista sea la distancia al cuadrado entre sus nodos y que no forme ciclos
+ * (con N-1 aristas y sin ciclos, el bosque conecta los N nodos).
+ *
+ * @tparam D Número de coordenadas de los nodos; se deduce de las aristas.
+ * @param arbol Aristas por verificar.
+ * @param N Número de nodos del grafo.
+ */
+template <int D>
+CertificadoMST verificarArbolCobertor(const std::vector<EdgeD<D>>& arbol, size_t N){
+    CertificadoMST r;
+    auto falla = [&r](const EdgeD<D>* e, const std::string& motivo){
+        std::ostringstream texto;
+        texto.precision(17);
+        if (e) texto << "la arista (" << e->n1->id << ", " << e->n2->id << ") ";
+        texto << motivo;
+        r.valido = false;
+        r.motivo = texto.str();
+        return r;
+    };
+    if (arbol.size() != (N > 0 ? N - 1 : 0)){
+        return falla(nullptr, "tiene " + std::to_string(arbol.size()) + " aristas y se esperaban " + std::to_string(N > 0 ? N - 1 : 0));
+    }
+
+    UnionFind uf(N);
+    for (const EdgeD<D>& e : arbol){
+        if (e.n1->id < 0 || e.n1->id >= (int)N || e.n2->id < 0 || e.n2->id >= (int)N) return falla(&e, "tiene un nodo fuera de rango");
+        if (e.n1->id == e.n2->id) return falla(&e, "es un self-loop");
+        if (e.peso != distanciaCuadrada(e.n1, e.n2)){
+            std::ostringstream motivo;
+            motivo.precision(17);
+            motivo << "tiene peso " << e.peso << " y la distancia al cuadrado entre sus nodos es " << distanciaCuadrada(e.n1, e.n2);
+            return falla(&e, motivo.str());
+        }
+        int raiz_x = uf.find(e.n1->id);
+        int raiz_y = uf.find(e.n2->id);
+        if (raiz_x == raiz_y) return falla(&e, "cierra un ciclo");
+        uf.union_(raiz_x, raiz_y);
+    }
+    return r;
+}
+
+/**
+ * @brief Verifica de forma exacta que un árbol sea un MST de un grafo.
+ *
+ * Un árbol cobertor es mínimo si y solo si cumple la propiedad del ciclo: ninguna arista del grafo es
+ * más liviana que la arista más pesada del camino del árbol entre sus extremos. Si alguna lo fuera,
+ * cambiarla por esa arista daría un árbol más liviano. La comprobación no depende de cómo se rompan los
+ * empates ni del orden en que se sumen los pesos, así que acepta cualquier MST del grafo y solo ese.
+ *
+ * Los máximos de los caminos se obtienen con `Dendrograma::alturaUnion`, en O(log N) por arista,
+ * así que la verificación toma O(M log N) y no usa ningún algoritmo de MST.
+ *
+ * @tparam D Número de coordenadas de los nodos; se deduce de las aristas.
+ * @param aristas Aristas del grafo; los ids de sus nodos deben estar en [0, N).
+ * @param N Número de nodos del grafo.
+ * @param arbol Árbol por verificar.
+ * @return Certificado con el primer problema encontrado, si hay alguno.
+ */
+template <int D>
+CertificadoMST verificarMST(const std::vector<EdgeD<D>>& aristas, size_t N, const std::vector<EdgeD<D>>& arbol){
+    CertificadoMST r = verificarArbolCobertor(arbol, N);
+    if (!r.valido) return r;
+
+    Dendrograma dendrograma(arbol, N);
+    for (const EdgeD<D>& e : aristas){
+        double maximo = dendrograma.alturaUnion(e.n1->id, e.n2->id);
+        if (e.peso < maximo){
+            std::ostringstream motivo;
+            motivo.precision(17);
+            motivo << "la arista (" << e.n1->id << ", " << e.n2->id << ") de peso " << e.peso
+                   << " es más liviana que la más pesada del camino del árbol entre sus nodos (" << maximo << ")";
+            r.valido = false;
+            r.motivo = motivo.str();
+            return r;
+        }
+    }
+    return r;
+}